@@ -9,6 +9,8 @@
 #include <nan.h>
 #include "sync.h"   // NOLINT(build/include)
 #include "async.h"  // NOLINT(build/include)
+#include "batch.h"  // NOLINT(build/include)
+#include "kernels.h"  // NOLINT(build/include)
 
 using v8::FunctionTemplate;
 using v8::Handle;
@@ -18,14 +20,23 @@ using Nan::GetFunction;
 using Nan::New;
 using Nan::Set;
 
-// Expose synchronous and asynchronous access to our
-// Estimate() function
+// Expose synchronous, asynchronous and batched access to our
+// Estimate() function, and the timings of its sampling kernels
 NAN_MODULE_INIT(InitAll) {
   Set(target, New<String>("calculateSync").ToLocalChecked(),
     GetFunction(New<FunctionTemplate>(CalculateSync)).ToLocalChecked());
 
   Set(target, New<String>("calculateAsync").ToLocalChecked(),
     GetFunction(New<FunctionTemplate>(CalculateAsync)).ToLocalChecked());
+
+  Set(target, New<String>("calculateAsyncSingle").ToLocalChecked(),
+    GetFunction(New<FunctionTemplate>(CalculateAsyncSingle)).ToLocalChecked());
+
+  Set(target, New<String>("calculateBatch").ToLocalChecked(),
+    GetFunction(New<FunctionTemplate>(CalculateBatch)).ToLocalChecked());
+
+  Set(target, New<String>("measureKernels").ToLocalChecked(),
+    GetFunction(New<FunctionTemplate>(MeasureKernels)).ToLocalChecked());
 }
 
 NODE_MODULE(addon, InitAll)
@@ -7,46 +7,97 @@
  ********************************************************************/
 
 var addon = require('./build/Release/addon');
-var calculations = process.argv[2] || 100000000;
+var bench = process.argv[2] === '--bench';
+var calculations = parseInt(process.argv[2], 10) || 100000000;
 
 function printResult(type, pi, ms) {
   console.log(type, 'method:')
   console.log('\tπ ≈ ' + pi
-  		+ ' (' + Math.abs(pi - Math.PI) + ' away from actual)')
-	console.log('\tTook ' + ms + 'ms');
-	console.log()
+      + ' (' + Math.abs(pi - Math.PI) + ' away from actual)')
+  console.log('\tTook ' + ms + 'ms');
+  console.log()
 }
 
 function runSync () {
   var start = Date.now();
   // Estimate() will execute in the current thread,
   // the next line won't return until it is finished
-	var result = addon.calculateSync(calculations);
+  var result = addon.calculateSync(calculations);
   printResult('Sync', result, Date.now() - start)
+  return result
 }
 
-function runAsync () {
-  // how many batches should we split the work in to?
-	var batches = process.argv[3] || 16;
-	var ended = 0;
-	var total = 0;
-	var start = Date.now();
-
-	function done (err, result) {
-		total += result;
-
-    // have all the batches finished executing?
-		if (++ended == batches) {
-			printResult('Async', total / batches, Date.now() - start)
-		}
-	}
-
-  // for each batch of work, request an async Estimate() for
-  // a portion of the total number of calculations
-	for (var i = 0; i < batches; i++) {
-		addon.calculateAsync(calculations / batches, done);
-	}
+function runAsync (syncResult) {
+  var start = Date.now();
+  var reported = 0;
+
+  function progress (fraction) {
+    // print every 10%
+    if (fraction >= reported + 0.1 || fraction === 1) {
+      reported = fraction
+      console.log('\t' + Math.round(fraction * 100) + '% done')
+    }
+  }
+
+  // a single call spreads the work over every core; the points are sampled
+  // in the same chunks as the sync method, so the results are identical
+  addon.calculateAsync(calculations, progress, function (err, result) {
+    printResult('Async', result, Date.now() - start)
+    console.log('Sync and async results ' +
+        (result === syncResult ? 'match' : 'differ'))
+    console.log()
+    runBatch(syncResult)
+  });
+}
+
+function runBatch (syncResult) {
+  var start = Date.now();
+  var sizes = [];
+  var completed = 0;
+
+  // halving sizes, so that one large item runs along many small ones
+  for (var i = 0; i < 8; i++)
+    sizes.push(Math.max(1, Math.floor(calculations / (1 << i))))
+
+  function partial (indices, estimates) {
+    completed += indices.length
+    console.log('\t' + completed + '/' + sizes.length + ' items done')
+  }
+
+  // one call submits every item, and one callback receives all estimates
+  addon.calculateBatch(sizes, partial, function (err, results) {
+    printResult('Batch (first of ' + sizes.length + ' items)', results[0],
+        Date.now() - start)
+    console.log('Sync and batch results ' +
+        (results[0] === syncResult ? 'match' : 'differ'))
+    console.log()
+    runKernels()
+  });
+}
+
+function runKernels () {
+  // every kernel samples the same points on this thread
+  var points = Math.min(calculations, 1 << 26);
+  var results = addon.measureKernels(points);
+
+  console.log('Kernels (' + points + ' points on one thread):')
+  results.forEach(function (result) {
+    if (!result.supported) {
+      console.log('\t' + result.kernel + ': not supported')
+      return
+    }
+    console.log('\t' + result.kernel + ': ' +
+        (result.samplesPerSec / 1e6).toFixed(1) + 'M samples/s' +
+        (result.best ? ' (used)' : ''))
+  })
+
+  var supported = results.filter(function (result) { return result.supported })
+  console.log('Kernel results ' + (supported.every(function (result) {
+    return result.estimate === supported[0].estimate
+  }) ? 'match' : 'differ'))
 }
 
-runSync()
-runAsync()
+if (bench)
+  require('./bench')(addon, process.argv[3] || 'bench.json')
+else
+  runAsync(runSync())
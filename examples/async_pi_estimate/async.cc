@@ -7,6 +7,7 @@
  ********************************************************************/
 
 #include <nan.h>
+#include <nan-check.h>
 #include "pi_est.h"  // NOLINT(build/include)
 #include "async.h"  // NOLINT(build/include)
 
@@ -14,26 +15,56 @@ using v8::Function;
 using v8::Local;
 using v8::Number;
 using v8::Value;
+using Nan::AsyncProgressWorker;
 using Nan::AsyncQueueWorker;
-using Nan::AsyncWorker;
 using Nan::Callback;
 using Nan::HandleScope;
 using Nan::New;
 using Nan::Null;
-using Nan::To;
 
-class PiWorker : public AsyncWorker {
+class PiWorker : public AsyncProgressWorker {
  public:
-  PiWorker(Callback *callback, int points)
-    : AsyncWorker(callback), points(points), estimate(0) {}
-  ~PiWorker() {}
+  PiWorker(Callback *callback, Callback *progress, uint32_t points,
+           bool parallel)
+    : AsyncProgressWorker(callback), progress(progress), points(points)
+    , parallel(parallel), estimate(0) {}
+  ~PiWorker() {
+    delete progress;
+  }
 
   // Executed inside the worker-thread.
   // It is not safe to access V8, or V8 data structures
   // here, so everything we need for input and output
   // should go on `this`.
-  void Execute () {
-    estimate = Estimate(points);
+  // EstimateParallel() spreads the points over every core
+  // and blocks this thread until all of them are done;
+  // otherwise Estimate() counts them on this thread alone.
+  void Execute(const ExecutionProgress &execution) {
+    if (!parallel) {
+      estimate = Estimate(points);
+      return;
+    }
+
+    EstimateProgress report;
+    if (progress) {
+      report = [&execution](uint64_t done, uint64_t total) {
+        double fraction = done / static_cast<double>(total);
+        execution.Send(reinterpret_cast<const char*>(&fraction), sizeof(fraction));
+      };
+    }
+    estimate = EstimateParallel(points, report);
+  }
+
+  // Executed in the main event loop with the latest
+  // progress sent from Execute()
+  void HandleProgressCallback(const char *data, size_t size) {
+    HandleScope scope;
+
+    Local<Value> argv[] = {
+        New<Number>(*reinterpret_cast<const double*>(data))
+    };
+
+    progress->Call(1, argv, async_resource);
   }
 
   // Executed when the async work is complete
@@ -47,18 +78,53 @@ class PiWorker : public AsyncWorker {
       , New<Number>(estimate)
     };
 
-    callback->Call(2, argv);
+    callback->Call(2, argv, async_resource);
   }
 
  private:
-  int points;
+  Callback *progress;
+  uint32_t points;
+  bool parallel;
   double estimate;
 };
 
-// Asynchronous access to the `Estimate()` function
+typedef Nan::Overloads<
+    Nan::Signature<uint32_t, Nan::Arg::Function>,
+    Nan::Signature<uint32_t, Nan::Arg::Function, Nan::Arg::Function>
+  > CalculateAsyncOverloads;
+
+// Asynchronous access to the `Estimate()` function:
+// calculateAsync(points, [progress], callback)
 NAN_METHOD(CalculateAsync) {
-  int points = To<int>(info[0]).FromJust();
-  Callback *callback = new Callback(info[1].As<Function>());
+  std::string error;
+
+  bool queued = CalculateAsyncOverloads::Dispatch(info, &error,
+    [](uint32_t points, Local<Function> callback) {
+      AsyncQueueWorker(new PiWorker(new Callback(callback), NULL, points,
+                                    true));
+    },
+    [](uint32_t points, Local<Function> progress, Local<Function> callback) {
+      AsyncQueueWorker(new PiWorker(new Callback(callback),
+                                    new Callback(progress), points, true));
+    });
+
+  if (!queued)
+    Nan::ThrowTypeError(error.c_str());
+}
+
+typedef Nan::Signature<uint32_t, Nan::Arg::Function>
+  CalculateAsyncSingleSignature;
+
+// Same estimate counted on the libuv thread running the job, without the
+// WorkerPool, so that jobs run concurrently up to the libuv thread pool size:
+// calculateAsyncSingle(points, callback)
+NAN_METHOD(CalculateAsyncSingle) {
+  uint32_t points = 0;
+  Local<Function> callback;
+  std::string error;
+
+  if (!CalculateAsyncSingleSignature::Check(info, &error, points, callback))
+    return Nan::ThrowTypeError(error.c_str());
 
-  AsyncQueueWorker(new PiWorker(callback, points));
+  AsyncQueueWorker(new PiWorker(new Callback(callback), NULL, points, false));
 }
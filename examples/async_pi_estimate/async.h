@@ -12,5 +12,6 @@
 #include <nan.h>
 
 NAN_METHOD(CalculateAsync);
+NAN_METHOD(CalculateAsyncSingle);
 
 #endif  // EXAMPLES_ASYNC_PI_ESTIMATE_ASYNC_H_
@@ -0,0 +1,161 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <nan.h>
+#include <nan-check.h>
+#include "pi_est.h"  // NOLINT(build/include)
+#include "batch.h"  // NOLINT(build/include)
+
+using v8::Array;
+using v8::Function;
+using v8::Local;
+using v8::Number;
+using v8::Value;
+using Nan::AsyncQueueWorker;
+using Nan::Callback;
+using Nan::HandleScope;
+using Nan::New;
+using Nan::Null;
+using Nan::Set;
+
+struct ItemEstimate {
+  uint32_t index;
+  double estimate;
+};
+
+// Progress carries the number of items completed so far: a newer count covers
+// every older one, so updates may be coalesced or dropped without losing items.
+class BatchWorker : public Nan::AsyncBatchProgressWorker<size_t, 16> {
+ public:
+  BatchWorker(Callback *callback, Callback *partial,
+              const std::vector<uint32_t> &items)
+    : AsyncBatchProgressWorker(callback, Nan::ProgressPolicy::Latest())
+    , partial(partial), points(items.begin(), items.end())
+    , finished(items.size()), ready(new std::atomic<bool>[items.size()])
+    , completedCount(0), sent(0), delivered(0) {
+    for (size_t i = 0; i < items.size(); ++i)
+      ready[i].store(false, std::memory_order_relaxed);
+  }
+  ~BatchWorker() {
+    delete partial;
+  }
+
+  // Executed inside the worker-thread.
+  // Items complete on any pool thread, while progress may only be sent from
+  // this one: completed items are queued in `finished`, and the length of its
+  // ready prefix is sent every time this thread has counted a chunk.
+  void Execute(const ExecutionProgress &execution) {
+    BatchCompletion completed;
+    EstimateProgress flush;
+    if (partial) {
+      completed = [this](size_t index, double estimate) {
+        size_t slot = completedCount.fetch_add(1, std::memory_order_relaxed);
+        finished[slot].index = static_cast<uint32_t>(index);
+        finished[slot].estimate = estimate;
+        ready[slot].store(true, std::memory_order_release);
+      };
+      flush = [this, &execution](uint64_t, uint64_t) {
+        Flush(execution);
+      };
+    }
+
+    estimates = EstimateBatch(points, completed, flush);
+    if (partial)
+      Flush(execution);
+  }
+
+  // Executed in the main event loop with the newest count of ready items;
+  // reports every item completed since the previous call, as
+  // partial(indices, estimates)
+  void HandleProgressCallback(const size_t *values, size_t count) {
+    size_t ready = values[count - 1];
+    if (ready <= delivered)
+      return;
+
+    const ItemEstimate *items = finished.data() + delivered;
+    int length = static_cast<int>(ready - delivered);
+    delivered = ready;
+
+    Local<Array> indices = New<Array>(length);
+    Local<Array> estimates = New<Array>(length);
+    for (int i = 0; i < length; ++i) {
+      Set(indices, static_cast<uint32_t>(i), New<Number>(items[i].index));
+      Set(estimates, static_cast<uint32_t>(i), New<Number>(items[i].estimate));
+    }
+
+    Local<Value> argv[] = { indices, estimates };
+    partial->Call(2, argv, async_resource);
+  }
+
+  // Executed when all items are done; the only required call back into JS
+  void HandleOKCallback() {
+    HandleScope scope;
+
+    Local<Array> results = New<Array>(static_cast<int>(estimates.size()));
+    for (size_t i = 0; i < estimates.size(); ++i)
+      Set(results, static_cast<uint32_t>(i), New<Number>(estimates[i]));
+
+    Local<Value> argv[] = {
+        Null()
+      , results
+    };
+
+    callback->Call(2, argv, async_resource);
+  }
+
+ private:
+  void Flush(const ExecutionProgress &execution) {
+    size_t count = sent;
+    while (count < finished.size() &&
+           ready[count].load(std::memory_order_acquire))
+      count++;
+
+    if (count != sent) {
+      sent = count;
+      execution.Send(sent);
+    }
+  }
+
+  Callback *partial;
+  std::vector<uint64_t> points;
+  std::vector<double> estimates;
+
+  // completed items, filled by pool threads in order of completion
+  std::vector<ItemEstimate> finished;
+  std::unique_ptr<std::atomic<bool>[]> ready;
+  std::atomic<size_t> completedCount;
+  size_t sent;  // touched by the Execute() thread only
+  size_t delivered;  // touched by the event loop thread only
+};
+
+typedef Nan::Overloads<
+    Nan::Signature<std::vector<uint32_t>, Nan::Arg::Function>,
+    Nan::Signature<std::vector<uint32_t>, Nan::Arg::Function, Nan::Arg::Function>
+  > CalculateBatchOverloads;
+
+// Estimates a whole batch with a single call and a single completion:
+// calculateBatch([points, ...], [partial], callback)
+NAN_METHOD(CalculateBatch) {
+  std::string error;
+
+  bool queued = CalculateBatchOverloads::Dispatch(info, &error,
+    [](const std::vector<uint32_t> &points, Local<Function> callback) {
+      AsyncQueueWorker(new BatchWorker(new Callback(callback), NULL, points));
+    },
+    [](const std::vector<uint32_t> &points, Local<Function> partial,
+       Local<Function> callback) {
+      AsyncQueueWorker(new BatchWorker(new Callback(callback),
+                                       new Callback(partial), points));
+    });
+
+  if (!queued)
+    Nan::ThrowTypeError(error.c_str());
+}
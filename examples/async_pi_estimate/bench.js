@@ -0,0 +1,211 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+// Throughput and latency of the async methods, swept over the number of jobs
+// submitted together and the points per job:
+//  - async: `jobs` calculateAsync() calls, each an AsyncQueueWorker spreading
+//    its points over the WorkerPool. The pool runs one job at a time, so the
+//    other jobs hold libuv threads while they wait for it.
+//  - single: `jobs` calculateAsyncSingle() calls, each counted on its own
+//    libuv thread; these run concurrently up to UV_THREADPOOL_SIZE.
+//  - batch: one calculateBatch() call of `jobs` items
+// For every run it records samples/s and jobs/s, the submit-to-callback
+// latency of each job (p50/p99/max) and the event loop lag meanwhile.
+
+var os = require('os');
+var fs = require('fs');
+
+var sizes = [1e4, 1e5, 1e6, 1e7];
+var jobCounts = [1, 4, 16, 64];
+
+function now () {
+  var t = process.hrtime();
+  return t[0] * 1e3 + t[1] / 1e6;
+}
+
+// Nearest-rank percentile of sorted `values`
+function percentile (values, fraction) {
+  if (values.length === 0)
+    return 0;
+  return values[Math.min(values.length - 1,
+                         Math.max(0, Math.ceil(fraction * values.length) - 1))];
+}
+
+function distribution (values) {
+  var sorted = values.slice().sort(function (a, b) { return a - b });
+  var sum = sorted.reduce(function (a, b) { return a + b }, 0);
+  return {
+    p50: percentile(sorted, 0.5),
+    p99: percentile(sorted, 0.99),
+    max: sorted.length ? sorted[sorted.length - 1] : 0,
+    mean: sorted.length ? sum / sorted.length : 0
+  };
+}
+
+// Delay of 1ms timers past their due time while the loop is busy
+function LagProbe () {
+  this.samples = [];
+  this.timer = null;
+}
+
+LagProbe.prototype.start = function () {
+  var self = this;
+  var due = now() + 1;
+
+  function tick () {
+    var t = now();
+    self.samples.push(Math.max(0, t - due));
+    due = t + 1;
+    self.timer = setTimeout(tick, 1);
+  }
+  this.timer = setTimeout(tick, 1);
+};
+
+LagProbe.prototype.stop = function () {
+  clearTimeout(this.timer);
+  return distribution(this.samples);
+};
+
+function runAsync (calculate, jobs, points, done) {
+  var latencies = [];
+  var remaining = jobs;
+  var start = now();
+
+  for (var i = 0; i < jobs; i++) {
+    (function (submitted) {
+      calculate(points, function () {
+        latencies.push(now() - submitted);
+        if (--remaining === 0)
+          done(now() - start, latencies);
+      });
+    })(now());
+  }
+}
+
+function runBatch (addon, jobs, points, done) {
+  var sizes = [];
+  var latencies = [];
+
+  for (var i = 0; i < jobs; i++)
+    sizes.push(points);
+
+  // every item is submitted at once; partial() tells when each one completes
+  var start = now();
+  addon.calculateBatch(sizes, function (indices) {
+    var t = now() - start;
+    for (var j = 0; j < indices.length; j++)
+      latencies.push(t);
+  }, function () {
+    // partial() has reported every item by now
+    done(now() - start, latencies);
+  });
+}
+
+var methods = {
+  async: function (addon, jobs, points, done) {
+    runAsync(addon.calculateAsync, jobs, points, done);
+  },
+  single: function (addon, jobs, points, done) {
+    runAsync(addon.calculateAsyncSingle, jobs, points, done);
+  },
+  batch: runBatch
+};
+
+function measure (addon, method, jobs, points, done) {
+  var probe = new LagProbe();
+
+  probe.start();
+  methods[method](addon, jobs, points, function (ms, latencies) {
+    done({
+      method: method,
+      jobs: jobs,
+      points: points,
+      ms: ms,
+      samplesPerSec: jobs * points / (ms / 1e3),
+      jobsPerSec: jobs / (ms / 1e3),
+      latencyMs: distribution(latencies),
+      eventLoopLagMs: probe.stop()
+    });
+  });
+}
+
+function pad (value, width) {
+  value = String(value);
+  while (value.length < width)
+    value = ' ' + value;
+  return value;
+}
+
+function print (result) {
+  console.log(pad(result.method, 6) + pad(result.jobs, 6) +
+      pad(result.points, 10) +
+      pad((result.samplesPerSec / 1e6).toFixed(1), 12) +
+      pad(result.jobsPerSec.toFixed(1), 10) +
+      pad(result.latencyMs.p50.toFixed(1), 9) +
+      pad(result.latencyMs.p99.toFixed(1), 9) +
+      pad(result.eventLoopLagMs.p99.toFixed(2), 10) +
+      pad(result.eventLoopLagMs.max.toFixed(2), 10));
+}
+
+module.exports = function (addon, output) {
+  var runs = [];
+  sizes.forEach(function (points) {
+    jobCounts.forEach(function (jobs) {
+      Object.keys(methods).forEach(function (method) {
+        runs.push([method, jobs, points]);
+      });
+    });
+  });
+
+  var report = {
+    date: new Date().toISOString(),
+    node: process.version,
+    platform: process.platform + ' ' + process.arch,
+    cpus: os.cpus().length,
+    cpuModel: os.cpus().length ? os.cpus()[0].model : '',
+    threadpoolSize: parseInt(process.env.UV_THREADPOOL_SIZE, 10) || 4,
+    // async and batch jobs take turns on the WorkerPool (one thread per core);
+    // threadpoolSize only bounds how many single jobs run at once
+    serializedMethods: ['async', 'batch'],
+    kernels: addon.measureKernels(1 << 22),
+    idleEventLoopLagMs: null,
+    results: []
+  };
+
+  console.log(pad('method', 6) + pad('jobs', 6) + pad('points', 10) +
+      pad('Msamples/s', 12) + pad('jobs/s', 10) + pad('p50 ms', 9) +
+      pad('p99 ms', 9) + pad('lag p99', 10) + pad('lag max', 10));
+
+  function next (i) {
+    if (i === runs.length) {
+      fs.writeFileSync(output, JSON.stringify(report, null, 2) + '\n');
+      console.log('\nResults written to ' + output);
+      return;
+    }
+
+    measure(addon, runs[i][0], runs[i][1], runs[i][2], function (result) {
+      report.results.push(result);
+      print(result);
+      next(i + 1);
+    });
+  }
+
+  // baseline lag of the idle loop, then a warm-up run of every method
+  var idle = new LagProbe();
+  idle.start();
+  setTimeout(function () {
+    report.idleEventLoopLagMs = idle.stop();
+    measure(addon, 'async', 4, 1e5, function () {
+      measure(addon, 'single', 4, 1e5, function () {
+        measure(addon, 'batch', 4, 1e5, function () {
+          next(0);
+        });
+      });
+    });
+  }, 200);
+};
@@ -5,8 +5,12 @@
       "sources": [
         "addon.cc",
         "pi_est.cc",
+        "pi_kernel.cc",
+        "worker_pool.cc",
         "sync.cc",
-        "async.cc"
+        "async.cc",
+        "batch.cc",
+        "kernels.cc"
       ],
       "include_dirs": [
         "<!(node -e \"require('nan')\")", 
@@ -26,7 +30,8 @@
         
             'libraries!': [ '-undefined dynamic_lookup' ],
             'cflags_cc!': [ '-fno-exceptions', '-fno-rtti' ],
-            "cflags": [ '-std=c++11', '-fexceptions', '-frtti' ],                    
+            "cflags": [ '-std=c++11', '-fexceptions', '-frtti', '-pthread' ],
+            "ldflags": [ '-pthread' ],
         }]
       ]
     }
@@ -0,0 +1,65 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+#include <chrono>
+#include "pi_est.h"  // NOLINT(build/include)
+#include "pi_kernel.h"  // NOLINT(build/include)
+#include "kernels.h"  // NOLINT(build/include)
+
+using v8::Array;
+using v8::Boolean;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::String;
+using Nan::New;
+using Nan::Set;
+
+// Times every sampling kernel over the same `points` on the calling thread
+// and returns [{ kernel, supported, best, samplesPerSec, estimate }, ...].
+// Unsupported kernels are listed without being run.
+NAN_METHOD(MeasureKernels) {
+  uint32_t points;
+  std::string error;
+
+  if (!Nan::Check(info).ArgumentsCount(1).Argument(0).Bind(points).Error(&error))
+    return Nan::ThrowTypeError(error.c_str());
+
+  Local<Array> results = New<Array>(kKernelCount);
+
+  for (int k = 0; k < kKernelCount; ++k) {
+    Kernel kernel = static_cast<Kernel>(k);
+    Local<Object> result = New<Object>();
+
+    Set(result, New<String>("kernel").ToLocalChecked(),
+        New<String>(KernelName(kernel)).ToLocalChecked());
+    Set(result, New<String>("supported").ToLocalChecked(),
+        New<Boolean>(KernelSupported(kernel)));
+    Set(result, New<String>("best").ToLocalChecked(),
+        New<Boolean>(kernel == BestKernel()));
+
+    if (KernelSupported(kernel) && points > 0) {
+      std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+      uint64_t inside = CountInsideWith(kernel, kSeed, 0, points);
+      double seconds = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - start).count();
+
+      Set(result, New<String>("samplesPerSec").ToLocalChecked(),
+          New<Number>(seconds > 0 ? points / seconds : 0));
+      Set(result, New<String>("estimate").ToLocalChecked(),
+          New<Number>((inside / static_cast<double>(points)) * 4));
+    }
+
+    Set(results, k, result);
+  }
+
+  info.GetReturnValue().Set(results);
+}
@@ -0,0 +1,16 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#ifndef EXAMPLES_ASYNC_PI_ESTIMATE_KERNELS_H_
+#define EXAMPLES_ASYNC_PI_ESTIMATE_KERNELS_H_
+
+#include <nan.h>
+
+NAN_METHOD(MeasureKernels);
+
+#endif  // EXAMPLES_ASYNC_PI_ESTIMATE_KERNELS_H_
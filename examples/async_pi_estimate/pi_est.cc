@@ -6,8 +6,13 @@
  * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
  ********************************************************************/
 
-#include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
 #include "pi_est.h"  // NOLINT(build/include)
+#include "pi_kernel.h"  // NOLINT(build/include)
+#include "worker_pool.h"  // NOLINT(build/include)
 
 /*
 Estimate the value of π by using a Monte Carlo method.
@@ -22,42 +27,109 @@ See https://en.wikipedia.org/wiki/File:Pi_30K.gif
 for a visualization of how this works.
 */
 
-inline int randall(unsigned int *p_seed) {
-// windows has thread safe rand()
-#ifdef _WIN32
-  return rand();  // NOLINT(runtime/threadsafe_fn)
-#else
-  return rand_r(p_seed);
-#endif
+uint64_t ChunkCount(uint64_t points) {
+  return (points + kChunkSize - 1) / kChunkSize;
 }
 
-double Estimate (int points) {
-  int i = points;
-  int inside = 0;
-  unsigned int randseed = 1;
+uint64_t CountInside(uint64_t chunk, uint64_t points) {
+  // the widest kernel the CPU supports; all of them count the same points
+  return CountInsideWith(BestKernel(), kSeed, chunk * kChunkSize, points);
+}
 
-#ifdef _WIN32
-  srand(randseed);
-#endif
+// Number of points sampled by `chunk`; the last chunk may be partial
+inline uint64_t ChunkPoints(uint64_t chunk, uint64_t points) {
+  return std::min(kChunkSize, points - chunk * kChunkSize);
+}
 
-  // unique seed for each run, for threaded use
-  unsigned int seed = randall(&randseed);
+double Estimate(uint64_t points) {
+  if (points == 0)
+    return 0;
 
-#ifdef _WIN32
-  srand(seed);
-#endif
+  uint64_t inside = 0;
+  for (uint64_t chunk = 0; chunk < ChunkCount(points); ++chunk)
+    inside += CountInside(chunk, ChunkPoints(chunk, points));
 
-  while (i-- > 0) {
-    double x = randall(&seed) / static_cast<double>(RAND_MAX);
-    double y = randall(&seed) / static_cast<double>(RAND_MAX);
+  // calculate ratio and multiply by 4 for π
+  return (inside / static_cast<double>(points)) * 4;
+}
 
-    // x & y and now values between 0 and 1
-    // now do a pythagorean diagonal calculation
-    // `1` represents our 1/4 circle
-    if ((x * x) + (y * y) <= 1)
-      inside++;
-  }
+double EstimateParallel(uint64_t points, const EstimateProgress &progress) {
+  if (points == 0)
+    return 0;
+
+  WorkerPool &pool = WorkerPool::Instance();
+  // per-thread partial sums, each updated once per chunk
+  std::vector<uint64_t> partial(pool.Size());
+  std::atomic<uint64_t> done(0);
+  uint64_t chunks = ChunkCount(points);
+
+  pool.ParallelFor(chunks, [&](uint64_t chunk, unsigned thread) {
+    partial[thread] += CountInside(chunk, ChunkPoints(chunk, points));
+
+    uint64_t finished = done.fetch_add(1, std::memory_order_relaxed) + 1;
+    // only the calling thread may report progress
+    if (thread == 0 && progress)
+      progress(finished, chunks);
+  });
+
+  uint64_t inside = 0;
+  for (size_t i = 0; i < partial.size(); ++i)
+    inside += partial[i];
 
   // calculate ratio and multiply by 4 for π
   return (inside / static_cast<double>(points)) * 4;
 }
+
+std::vector<double> EstimateBatch(const std::vector<uint64_t> &points,
+                                  const BatchCompletion &completed,
+                                  const EstimateProgress &progress) {
+  size_t count = points.size();
+  std::vector<double> estimates(count);
+
+  // first[i] is the first chunk of item i in the batch-wide numbering
+  std::vector<uint64_t> first(count + 1);
+  for (size_t i = 0; i < count; ++i)
+    first[i + 1] = first[i] + ChunkCount(points[i]);
+
+  std::unique_ptr<std::atomic<uint64_t>[]> inside(
+      new std::atomic<uint64_t>[count]);
+  std::unique_ptr<std::atomic<uint64_t>[]> remaining(
+      new std::atomic<uint64_t>[count]);
+
+  for (size_t i = 0; i < count; ++i) {
+    inside[i].store(0, std::memory_order_relaxed);
+    remaining[i].store(first[i + 1] - first[i], std::memory_order_relaxed);
+
+    // items without points have no chunks to complete them
+    if (points[i] == 0 && completed)
+      completed(i, 0);
+  }
+
+  WorkerPool &pool = WorkerPool::Instance();
+  std::atomic<uint64_t> done(0);
+  uint64_t chunks = first[count];
+
+  pool.ParallelFor(chunks, [&](uint64_t global, unsigned thread) {
+    // the last item starting at or before `global`; empty items are skipped
+    size_t item = std::upper_bound(first.begin(), first.end(), global)
+        - first.begin() - 1;
+    uint64_t chunk = global - first[item];
+
+    inside[item].fetch_add(CountInside(chunk, ChunkPoints(chunk, points[item])),
+                           std::memory_order_relaxed);
+
+    // whoever counts the last chunk of an item completes it
+    if (remaining[item].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      uint64_t total = inside[item].load(std::memory_order_relaxed);
+      estimates[item] = (total / static_cast<double>(points[item])) * 4;
+      if (completed)
+        completed(item, estimates[item]);
+    }
+
+    uint64_t finished = done.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (thread == 0 && progress)
+      progress(finished, chunks);
+  });
+
+  return estimates;
+}
@@ -9,6 +9,41 @@
 #ifndef EXAMPLES_ASYNC_PI_ESTIMATE_PI_EST_H_
 #define EXAMPLES_ASYNC_PI_ESTIMATE_PI_EST_H_
 
-double Estimate(int points);
+#include <stdint.h>
+#include <functional>
+#include <vector>
+
+// Points are sampled in chunks of this size. Point i always takes the i-th
+// draw of the counter-based stream `kSeed` (see pi_kernel.h), so the estimate
+// only depends on the number of points and never on how the chunks were spread
+// over threads, or on which kernel counted them.
+const uint64_t kChunkSize = 1 << 20;
+
+const uint64_t kSeed = 0x5EED5EED5EED5EEDull;
+
+// Called with the number of finished chunks out of the total
+typedef std::function<void(uint64_t done, uint64_t total)> EstimateProgress;
+
+uint64_t ChunkCount(uint64_t points);
+
+// Number of points of `chunk` that fall inside the quarter circle
+uint64_t CountInside(uint64_t chunk, uint64_t points);
+
+// Single-threaded estimate
+double Estimate(uint64_t points);
+
+// Same estimate computed over all threads of the WorkerPool
+double EstimateParallel(uint64_t points, const EstimateProgress &progress);
+
+// Called from any pool thread once every chunk of batch item `index` is counted
+typedef std::function<void(size_t index, double estimate)> BatchCompletion;
+
+// Estimates every entry of `points` in a single ParallelFor over the WorkerPool.
+// The chunks of all items are spread together, so items of different sizes
+// balance out; each estimate is identical to Estimate(points[i]).
+// `progress` is called on the calling thread only, as in EstimateParallel().
+std::vector<double> EstimateBatch(const std::vector<uint64_t> &points,
+                                  const BatchCompletion &completed,
+                                  const EstimateProgress &progress);
 
 #endif  // EXAMPLES_ASYNC_PI_ESTIMATE_PI_EST_H_
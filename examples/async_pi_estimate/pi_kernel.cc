@@ -0,0 +1,449 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include "pi_kernel.h"  // NOLINT(build/include)
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || \
+    defined(_M_IX86)
+#define PI_KERNEL_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define PI_KERNEL_X86 0
+#endif
+
+// Vector kernels are compiled for their instruction set function by function,
+// so the addon needs no special flags and still runs on older CPUs
+#if PI_KERNEL_X86 && defined(__GNUC__)
+#define PI_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PI_TARGET(isa)
+#endif
+
+/*
+Every sample takes one half of a Philox4x32-10 block: counter q yields the
+coordinates of points 2q and 2q + 1. Coordinates are the top 31 bits of each
+output word, so x² + y² fits in 63 bits and the test against the radius
+r² = 2^62 is exact integer arithmetic, identical in every kernel.
+*/
+
+namespace {
+
+const uint32_t kMul0 = 0xD2511F53;
+const uint32_t kMul1 = 0xCD9E8D57;
+const uint32_t kWeyl0 = 0x9E3779B9;
+const uint32_t kWeyl1 = 0xBB67AE85;
+const int kRounds = 10;
+
+// Counts the points outside the circle of `blocks` counters from `q`
+typedef uint64_t (*OutsideBlocks)(uint32_t k0, uint32_t k1, uint64_t q,
+                                  uint64_t blocks);
+
+inline void Philox(uint64_t q, uint32_t k0, uint32_t k1, uint32_t c[4]) {
+  c[0] = static_cast<uint32_t>(q);
+  c[1] = static_cast<uint32_t>(q >> 32);
+  c[2] = 0;
+  c[3] = 0;
+
+  for (int r = 0; r < kRounds; ++r) {
+    uint64_t p0 = static_cast<uint64_t>(kMul0) * c[0];
+    uint64_t p1 = static_cast<uint64_t>(kMul1) * c[2];
+
+    uint32_t c1 = c[1];
+    c[0] = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    c[1] = static_cast<uint32_t>(p1);
+    c[2] = static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1;
+    c[3] = static_cast<uint32_t>(p0);
+
+    k0 += kWeyl0;
+    k1 += kWeyl1;
+  }
+}
+
+// 1 when the point is outside the quarter circle, 0 otherwise
+inline uint64_t Outside(uint32_t x, uint32_t y) {
+  uint64_t xx = x >> 1;
+  uint64_t yy = y >> 1;
+  return (xx * xx + yy * yy) >> 62;
+}
+
+uint64_t OutsideScalar(uint32_t k0, uint32_t k1, uint64_t q,
+                       uint64_t blocks) {
+  uint64_t outside = 0;
+  uint32_t c[4];
+
+  for (uint64_t i = 0; i < blocks; ++i) {
+    Philox(q + i, k0, k1, c);
+    outside += Outside(c[0], c[1]) + Outside(c[2], c[3]);
+  }
+  return outside;
+}
+
+// Round keys, the same for every lane
+inline void KeySchedule(uint32_t k0, uint32_t k1, uint32_t keys0[kRounds],
+                        uint32_t keys1[kRounds]) {
+  for (int r = 0; r < kRounds; ++r) {
+    keys0[r] = k0;
+    keys1[r] = k1;
+    k0 += kWeyl0;
+    k1 += kWeyl1;
+  }
+}
+
+// Whether the low counter word wraps within the next `lanes` counters,
+// which only the scalar kernel handles
+inline bool Wraps(uint64_t q, uint32_t lanes) {
+  return static_cast<uint32_t>(q) > 0xFFFFFFFFu - (lanes - 1);
+}
+
+#if PI_KERNEL_X86
+
+//////////////////////////////////////////////////////////////////////////
+// SSE2: 4 counters per step
+
+PI_TARGET("sse2")
+inline void MulHiLo(__m128i a, __m128i m, __m128i *hi, __m128i *lo) {
+  __m128i even = _mm_mul_epu32(a, m);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+
+  *lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                           _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+  *hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 3, 1)),
+                           _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 3, 1)));
+}
+
+PI_TARGET("sse2")
+inline __m128i Outside(__m128i x, __m128i y) {
+  x = _mm_srli_epi32(x, 1);
+  y = _mm_srli_epi32(y, 1);
+
+  __m128i even = _mm_add_epi64(_mm_mul_epu32(x, x), _mm_mul_epu32(y, y));
+  x = _mm_srli_epi64(x, 32);
+  y = _mm_srli_epi64(y, 32);
+  __m128i odd = _mm_add_epi64(_mm_mul_epu32(x, x), _mm_mul_epu32(y, y));
+
+  return _mm_add_epi64(_mm_srli_epi64(even, 62), _mm_srli_epi64(odd, 62));
+}
+
+PI_TARGET("sse2")
+uint64_t OutsideSSE2(uint32_t k0, uint32_t k1, uint64_t q, uint64_t blocks) {
+  const uint32_t kLanes = 4;
+  uint32_t keys0[kRounds], keys1[kRounds];
+  KeySchedule(k0, k1, keys0, keys1);
+
+  const __m128i mul0 = _mm_set1_epi32(static_cast<int>(kMul0));
+  const __m128i mul1 = _mm_set1_epi32(static_cast<int>(kMul1));
+  const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+  __m128i sum = _mm_setzero_si128();
+  uint64_t outside = 0;
+  uint64_t i = 0;
+
+  for (; i + kLanes <= blocks; i += kLanes) {
+    if (Wraps(q + i, kLanes)) {
+      outside += OutsideScalar(k0, k1, q + i, kLanes);
+      continue;
+    }
+
+    __m128i c0 = _mm_add_epi32(
+        _mm_set1_epi32(static_cast<int>(static_cast<uint32_t>(q + i))), lane);
+    __m128i c1 = _mm_set1_epi32(static_cast<int>((q + i) >> 32));
+    __m128i c2 = _mm_setzero_si128();
+    __m128i c3 = _mm_setzero_si128();
+
+    for (int r = 0; r < kRounds; ++r) {
+      __m128i hi0, lo0, hi1, lo1;
+      MulHiLo(c0, mul0, &hi0, &lo0);
+      MulHiLo(c2, mul1, &hi1, &lo1);
+
+      c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1),
+                         _mm_set1_epi32(static_cast<int>(keys0[r])));
+      c1 = lo1;
+      c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3),
+                         _mm_set1_epi32(static_cast<int>(keys1[r])));
+      c3 = lo0;
+    }
+
+    sum = _mm_add_epi64(sum, _mm_add_epi64(Outside(c0, c1), Outside(c2, c3)));
+  }
+
+  uint64_t lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), sum);
+  return outside + lanes[0] + lanes[1] +
+         OutsideScalar(k0, k1, q + i, blocks - i);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// AVX2: 8 counters per step
+
+PI_TARGET("avx2")
+inline void MulHiLo(__m256i a, __m256i m, __m256i *hi, __m256i *lo) {
+  __m256i even = _mm256_mul_epu32(a, m);
+  __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+
+  *lo = _mm256_mullo_epi32(a, m);
+  *hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+PI_TARGET("avx2")
+inline __m256i Outside(__m256i x, __m256i y) {
+  x = _mm256_srli_epi32(x, 1);
+  y = _mm256_srli_epi32(y, 1);
+
+  __m256i even = _mm256_add_epi64(_mm256_mul_epu32(x, x),
+                                  _mm256_mul_epu32(y, y));
+  x = _mm256_srli_epi64(x, 32);
+  y = _mm256_srli_epi64(y, 32);
+  __m256i odd = _mm256_add_epi64(_mm256_mul_epu32(x, x),
+                                 _mm256_mul_epu32(y, y));
+
+  return _mm256_add_epi64(_mm256_srli_epi64(even, 62),
+                          _mm256_srli_epi64(odd, 62));
+}
+
+PI_TARGET("avx2")
+uint64_t OutsideAVX2(uint32_t k0, uint32_t k1, uint64_t q, uint64_t blocks) {
+  const uint32_t kLanes = 8;
+  uint32_t keys0[kRounds], keys1[kRounds];
+  KeySchedule(k0, k1, keys0, keys1);
+
+  const __m256i mul0 = _mm256_set1_epi32(static_cast<int>(kMul0));
+  const __m256i mul1 = _mm256_set1_epi32(static_cast<int>(kMul1));
+  const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  __m256i sum = _mm256_setzero_si256();
+  uint64_t outside = 0;
+  uint64_t i = 0;
+
+  for (; i + kLanes <= blocks; i += kLanes) {
+    if (Wraps(q + i, kLanes)) {
+      outside += OutsideScalar(k0, k1, q + i, kLanes);
+      continue;
+    }
+
+    __m256i c0 = _mm256_add_epi32(
+        _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(q + i))),
+        lane);
+    __m256i c1 = _mm256_set1_epi32(static_cast<int>((q + i) >> 32));
+    __m256i c2 = _mm256_setzero_si256();
+    __m256i c3 = _mm256_setzero_si256();
+
+    for (int r = 0; r < kRounds; ++r) {
+      __m256i hi0, lo0, hi1, lo1;
+      MulHiLo(c0, mul0, &hi0, &lo0);
+      MulHiLo(c2, mul1, &hi1, &lo1);
+
+      c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1),
+                            _mm256_set1_epi32(static_cast<int>(keys0[r])));
+      c1 = lo1;
+      c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3),
+                            _mm256_set1_epi32(static_cast<int>(keys1[r])));
+      c3 = lo0;
+    }
+
+    sum = _mm256_add_epi64(sum,
+                           _mm256_add_epi64(Outside(c0, c1), Outside(c2, c3)));
+  }
+
+  uint64_t lanes[4];
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sum);
+  return outside + lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+         OutsideScalar(k0, k1, q + i, blocks - i);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// AVX-512: 16 counters per step
+
+// GCC 12 warns about the deliberately undefined vectors that its own
+// AVX-512 intrinsics start from
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+PI_TARGET("avx512f")
+inline void MulHiLo(__m512i a, __m512i m, __m512i *hi, __m512i *lo) {
+  __m512i even = _mm512_mul_epu32(a, m);
+  __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), m);
+
+  *lo = _mm512_mullo_epi32(a, m);
+  *hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+}
+
+PI_TARGET("avx512f")
+inline __m512i Outside(__m512i x, __m512i y) {
+  x = _mm512_srli_epi32(x, 1);
+  y = _mm512_srli_epi32(y, 1);
+
+  __m512i even = _mm512_add_epi64(_mm512_mul_epu32(x, x),
+                                  _mm512_mul_epu32(y, y));
+  x = _mm512_srli_epi64(x, 32);
+  y = _mm512_srli_epi64(y, 32);
+  __m512i odd = _mm512_add_epi64(_mm512_mul_epu32(x, x),
+                                 _mm512_mul_epu32(y, y));
+
+  return _mm512_add_epi64(_mm512_srli_epi64(even, 62),
+                          _mm512_srli_epi64(odd, 62));
+}
+
+PI_TARGET("avx512f")
+uint64_t OutsideAVX512(uint32_t k0, uint32_t k1, uint64_t q,
+                       uint64_t blocks) {
+  const uint32_t kLanes = 16;
+  uint32_t keys0[kRounds], keys1[kRounds];
+  KeySchedule(k0, k1, keys0, keys1);
+
+  const __m512i mul0 = _mm512_set1_epi32(static_cast<int>(kMul0));
+  const __m512i mul1 = _mm512_set1_epi32(static_cast<int>(kMul1));
+  const __m512i lane = _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+                                        7, 6, 5, 4, 3, 2, 1, 0);
+  __m512i sum = _mm512_setzero_si512();
+  uint64_t outside = 0;
+  uint64_t i = 0;
+
+  for (; i + kLanes <= blocks; i += kLanes) {
+    if (Wraps(q + i, kLanes)) {
+      outside += OutsideScalar(k0, k1, q + i, kLanes);
+      continue;
+    }
+
+    __m512i c0 = _mm512_add_epi32(
+        _mm512_set1_epi32(static_cast<int>(static_cast<uint32_t>(q + i))),
+        lane);
+    __m512i c1 = _mm512_set1_epi32(static_cast<int>((q + i) >> 32));
+    __m512i c2 = _mm512_setzero_si512();
+    __m512i c3 = _mm512_setzero_si512();
+
+    for (int r = 0; r < kRounds; ++r) {
+      __m512i hi0, lo0, hi1, lo1;
+      MulHiLo(c0, mul0, &hi0, &lo0);
+      MulHiLo(c2, mul1, &hi1, &lo1);
+
+      c0 = _mm512_xor_si512(_mm512_xor_si512(hi1, c1),
+                            _mm512_set1_epi32(static_cast<int>(keys0[r])));
+      c1 = lo1;
+      c2 = _mm512_xor_si512(_mm512_xor_si512(hi0, c3),
+                            _mm512_set1_epi32(static_cast<int>(keys1[r])));
+      c3 = lo0;
+    }
+
+    sum = _mm512_add_epi64(sum,
+                           _mm512_add_epi64(Outside(c0, c1), Outside(c2, c3)));
+  }
+
+  return outside + _mm512_reduce_add_epi64(sum) +
+         OutsideScalar(k0, k1, q + i, blocks - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+
+bool CpuSupports(Kernel kernel) {
+#if defined(__GNUC__)
+  __builtin_cpu_init();
+  switch (kernel) {
+    case kSSE2:   return __builtin_cpu_supports("sse2");
+    case kAVX2:   return __builtin_cpu_supports("avx2");
+    case kAVX512: return __builtin_cpu_supports("avx512f");
+    default:      return true;
+  }
+#elif defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  bool sse2 = (info[3] & (1 << 26)) != 0;
+  // the OS must save the AVX (and AVX-512) registers on context switches
+  bool osxsave = (info[2] & (1 << 27)) != 0;
+  uint64_t xcr0 = osxsave ? _xgetbv(0) : 0;
+
+  __cpuidex(info, 7, 0);
+  switch (kernel) {
+    case kSSE2:   return sse2;
+    case kAVX2:   return (xcr0 & 0x06) == 0x06 && (info[1] & (1 << 5)) != 0;
+    case kAVX512: return (xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+    default:      return true;
+  }
+#else
+  return kernel == kScalar;
+#endif
+}
+
+const OutsideBlocks kKernels[kKernelCount] = {
+  OutsideScalar, OutsideSSE2, OutsideAVX2, OutsideAVX512
+};
+
+#else
+
+bool CpuSupports(Kernel kernel) {
+  return kernel == kScalar;
+}
+
+const OutsideBlocks kKernels[kKernelCount] = {
+  OutsideScalar, OutsideScalar, OutsideScalar, OutsideScalar
+};
+
+#endif  // PI_KERNEL_X86
+
+}  // namespace
+
+const char *KernelName(Kernel kernel) {
+  static const char *names[kKernelCount] = {
+    "scalar", "sse2", "avx2", "avx512"
+  };
+  return kernel < kKernelCount ? names[kernel] : "unknown";
+}
+
+bool KernelSupported(Kernel kernel) {
+  // CPU features never change while the process runs
+  static const bool supported[kKernelCount] = {
+    true, CpuSupports(kSSE2), CpuSupports(kAVX2), CpuSupports(kAVX512)
+  };
+  return kernel < kKernelCount && supported[kernel];
+}
+
+Kernel BestKernel() {
+  static const Kernel best = KernelSupported(kAVX512) ? kAVX512
+                           : KernelSupported(kAVX2) ? kAVX2
+                           : KernelSupported(kSSE2) ? kSSE2
+                           : kScalar;
+  return best;
+}
+
+uint64_t CountInsideWith(Kernel kernel, uint64_t seed, uint64_t first,
+                         uint64_t count) {
+  if (!KernelSupported(kernel))
+    kernel = kScalar;
+
+  uint32_t k0 = static_cast<uint32_t>(seed);
+  uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+  uint64_t end = first + count;
+  uint64_t outside = 0;
+  uint32_t c[4];
+
+  // a range starting at an odd point takes the second half of its first block
+  if (first < end && (first & 1)) {
+    Philox(first >> 1, k0, k1, c);
+    outside += Outside(c[2], c[3]);
+    ++first;
+  }
+
+  uint64_t blocks = (end - first) / 2;
+  outside += kKernels[kernel](k0, k1, first >> 1, blocks);
+  first += blocks * 2;
+
+  // and a range ending at an even point the first half of its last block
+  if (first < end) {
+    Philox(first >> 1, k0, k1, c);
+    outside += Outside(c[0], c[1]);
+  }
+
+  return count - outside;
+}
@@ -0,0 +1,39 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#ifndef EXAMPLES_ASYNC_PI_ESTIMATE_PI_KERNEL_H_
+#define EXAMPLES_ASYNC_PI_ESTIMATE_PI_KERNEL_H_
+
+#include <stdint.h>
+
+// Sampling kernels, from the portable one to the widest vectors.
+// Every kernel returns exactly the same counts.
+enum Kernel {
+  kScalar,
+  kSSE2,
+  kAVX2,
+  kAVX512,
+  kKernelCount
+};
+
+const char *KernelName(Kernel kernel);
+
+// Whether this build and the CPU it runs on can use `kernel`
+bool KernelSupported(Kernel kernel);
+
+// Widest supported kernel, detected once
+Kernel BestKernel();
+
+// Number of the points [first, first + count) of the stream `seed` that fall
+// inside the quarter circle. Coordinates come from Philox4x32-10, a
+// counter-based generator: point i depends only on `seed` and i, so any split
+// of a stream into ranges counts the same points.
+uint64_t CountInsideWith(Kernel kernel, uint64_t seed, uint64_t first,
+                         uint64_t count);
+
+#endif  // EXAMPLES_ASYNC_PI_ESTIMATE_PI_KERNEL_H_
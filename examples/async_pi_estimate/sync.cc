@@ -7,13 +7,19 @@
  ********************************************************************/
 
 #include <nan.h>
+#include <nan-check.h>
 #include "pi_est.h"  // NOLINT(build/include)
 #include "sync.h"  // NOLINT(build/include)
 
 // Simple synchronous access to the `Estimate()` function
 NAN_METHOD(CalculateSync) {
   // expect a number as the first argument
-  int points = info[0]->Uint32Value();
+  uint32_t points;
+  std::string error;
+
+  if (!Nan::Check(info).ArgumentsCount(1).Argument(0).Bind(points).Error(&error))
+    return Nan::ThrowTypeError(error.c_str());
+
   double est = Estimate(points);
 
   info.GetReturnValue().Set(est);
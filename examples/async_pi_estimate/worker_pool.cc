@@ -0,0 +1,99 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <atomic>
+#include "worker_pool.h"  // NOLINT(build/include)
+
+struct WorkerPool::Job {
+  const Body *body;
+  uint64_t count;
+  std::atomic<uint64_t> next;
+};
+
+WorkerPool &WorkerPool::Instance() {
+  // Never destroyed: the threads must outlive every addon call
+  static WorkerPool *pool = new WorkerPool(std::thread::hardware_concurrency());
+  return *pool;
+}
+
+WorkerPool::WorkerPool(unsigned size)
+  : job(NULL), generation(0), active(0), stopping(false) {
+  // the calling thread is one of the `size` threads
+  for (unsigned i = 1; i < size; ++i)
+    threads.push_back(std::thread(&WorkerPool::Loop, this, i));
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  wake.notify_all();
+
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+}
+
+unsigned WorkerPool::Size() const {
+  return static_cast<unsigned>(threads.size()) + 1;
+}
+
+void WorkerPool::ParallelFor(uint64_t count, const Body &body) {
+  std::lock_guard<std::mutex> serialize(submit);
+
+  Job current;
+  current.body = &body;
+  current.count = count;
+  current.next = 0;
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    job = &current;
+    active = static_cast<unsigned>(threads.size());
+    ++generation;
+  }
+  wake.notify_all();
+
+  Run(&current, 0);
+
+  // `current` lives on this stack, so wait until every thread has left it
+  std::unique_lock<std::mutex> guard(lock);
+  finished.wait(guard, [this] { return active == 0; });
+  job = NULL;
+}
+
+void WorkerPool::Loop(unsigned thread) {
+  uint64_t seen = 0;
+
+  for (;;) {
+    Job *current;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      wake.wait(guard, [&] { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+      current = job;
+    }
+
+    Run(current, thread);
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (--active == 0)
+      finished.notify_one();
+  }
+}
+
+void WorkerPool::Run(Job *job, unsigned thread) {
+  for (;;) {
+    uint64_t index = job->next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= job->count)
+      return;
+    (*job->body)(index, thread);
+  }
+}
@@ -0,0 +1,54 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#ifndef EXAMPLES_ASYNC_PI_ESTIMATE_WORKER_POOL_H_
+#define EXAMPLES_ASYNC_PI_ESTIMATE_WORKER_POOL_H_
+
+#include <stdint.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads sized to the hardware, shared by all calls.
+// The thread calling ParallelFor() takes part in the work as thread 0.
+class WorkerPool {
+ public:
+  typedef std::function<void(uint64_t index, unsigned thread)> Body;
+
+  static WorkerPool &Instance();
+
+  explicit WorkerPool(unsigned size);
+  ~WorkerPool();
+
+  // Number of threads running a ParallelFor(), including the caller
+  unsigned Size() const;
+
+  // Calls body(index, thread) for every index in [0, count) and returns once
+  // all of them are done. Calls from several threads are serialized.
+  void ParallelFor(uint64_t count, const Body &body);
+
+ private:
+  struct Job;
+
+  void Loop(unsigned thread);
+  static void Run(Job *job, unsigned thread);
+
+  std::vector<std::thread> threads;
+  std::mutex submit;  // one job at a time
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  Job *job;
+  uint64_t generation;
+  unsigned active;
+  bool stopping;
+};
+
+#endif  // EXAMPLES_ASYNC_PI_ESTIMATE_WORKER_POOL_H_
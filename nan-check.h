@@ -21,7 +21,66 @@
 #include <sstream>
 #include <array>
 #include <map>
+#include <unordered_map>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <vector>
+#include <cassert>
 #include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+/**
+ * Define NANCHECK_ENABLE_METRICS=1 to record per-method validation metrics (see Nan::CheckMetrics).
+ * When disabled, method names passed to Nan::Check are ignored and nothing is recorded.
+ */
+#ifndef NANCHECK_ENABLE_METRICS
+#define NANCHECK_ENABLE_METRICS 0
+#endif
+
+/**
+ * Environment cleanup hooks (node 10.2+) destroy the per-isolate state of nan-check (see Nan::IsolateContext)
+ * when a worker thread exits. Older versions run a single isolate that lives until the process exits.
+ */
+#if defined(NODE_MAJOR_VERSION) && (NODE_MAJOR_VERSION > 10 || (NODE_MAJOR_VERSION == 10 && NODE_MINOR_VERSION >= 2))
+#define NANCHECK_CLEANUP_HOOKS 1
+#else
+#define NANCHECK_CLEANUP_HOOKS 0
+#endif
+
+/**
+ * NANCHECK_VALIDATION_SAMPLE_RATE sets how often type checks run by default (see Nan::CheckSampling):
+ * 1 checks every call, N checks one call in N, 0 trusts the caller.
+ */
+#ifndef NANCHECK_VALIDATION_SAMPLE_RATE
+#define NANCHECK_VALIDATION_SAMPLE_RATE 1
+#endif
+
+/**
+ * Define NANCHECK_ALWAYS_VALIDATE=1 to check every call whatever the sampling rate. It defaults to 1 in debug builds,
+ * recognized by DEBUG or _DEBUG as node-gyp defines them; node-gyp Release builds do not define NDEBUG.
+ */
+#ifndef NANCHECK_ALWAYS_VALIDATE
+#if defined(DEBUG) || defined(_DEBUG)
+#define NANCHECK_ALWAYS_VALIDATE 1
+#else
+#define NANCHECK_ALWAYS_VALIDATE 0
+#endif
+#endif
+
+#if NANCHECK_ENABLE_METRICS
+#ifndef NANCHECK_METRICS_CAPACITY
+#define NANCHECK_METRICS_CAPACITY 128
+#endif
+#endif
 
 #if _MSC_VER
 #define NANCHECK_NOTHROW _THROW0()
@@ -29,9 +88,162 @@
 #define NANCHECK_NOTHROW noexcept
 #endif
 
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define NANCHECK_THREAD_LOCAL __declspec(thread)
+#else
+#define NANCHECK_THREAD_LOCAL thread_local
+#endif
+
 namespace Nan
 {
 
+    /**
+     * @brief Coarse JS type of an argument, as reported in CheckFailure
+     */
+    enum class ArgType
+    {
+        Unknown,
+        Undefined,
+        Null,
+        Boolean,
+        Number,
+        String,
+        Function,
+        Buffer,
+        TypedArray,
+        Array,
+        Object
+    };
+
+    /**
+     * @brief Bits describing the JS type of an argument. Primitives and their wrapper objects
+     *        are told apart so that every check keeps its exact semantics.
+     */
+    namespace ArgTrait
+    {
+        enum : uint16_t
+        {
+            Undefined       = 1 << 0,
+            Null            = 1 << 1,
+            Boolean         = 1 << 2,
+            Number          = 1 << 3,
+            String          = 1 << 4,
+            Object          = 1 << 5,
+            Function        = 1 << 6,
+            Array           = 1 << 7,
+            Buffer          = 1 << 8,
+            TypedArray      = 1 << 9,
+            BooleanObject   = 1 << 10,
+            NumberObject    = 1 << 11,
+            StringObject    = 1 << 12
+        };
+    }
+
+    /**
+     * @brief Classifies a value into ArgTrait bits with as few V8 type queries as possible
+     */
+    uint16_t ClassifyTraits(v8::Local<v8::Value> value);
+    ArgType ArgTypeOf(uint16_t traits);
+
+    ArgType ClassifyArgument(v8::Local<v8::Value> value);
+    const char * ArgTypeName(ArgType type);
+
+    /**
+     * @brief ArgTrait bits of every argument of a call, classified once and shared by all checks.
+     *        Indices past the last argument read as Undefined, like the arguments themselves.
+     */
+    class ArgumentFingerprint
+    {
+    public:
+        static const int kInline = 16;
+
+        ArgumentFingerprint();
+        explicit ArgumentFingerprint(Nan::NAN_METHOD_ARGS_TYPE args);
+
+        void Classify(Nan::NAN_METHOD_ARGS_TYPE args);
+
+        int Length() const;
+        uint16_t Traits(int index) const;
+        ArgType Type(int index) const;
+
+        /**
+         * Whether the argument has any of the given ArgTrait bits
+         */
+        bool Is(int index, uint16_t traits) const;
+
+    private:
+        uint16_t                mInline[kInline];
+        std::vector<uint16_t>   mOverflow;
+        int                     mLength;
+    };
+
+    enum class CheckErrorCode
+    {
+        None,
+        ArgumentsCount,
+        Check,
+        Bind,
+        Unknown,
+        Overload,
+        Exception
+    };
+
+    /**
+     * @brief Compact record of a failed check. Nothing is formatted until Message() is called.
+     */
+    struct CheckFailure
+    {
+        CheckFailure();
+
+        static CheckFailure ArgumentsCount(int actual, int expected1, int expected2);
+        static CheckFailure Violation(CheckErrorCode code, int argIndex, const char * check,
+                                      ArgType expected, v8::Local<v8::Value> actual);
+        static CheckFailure Violation(CheckErrorCode code, int argIndex, const char * check,
+                                      ArgType expected, ArgType actual);
+        static CheckFailure Overload(int actualCount, const char * overloads);
+
+        std::string Message() const;
+
+        /**
+         * Throws the message as a TypeError, except for CheckErrorCode::Exception:
+         * the exception raised by JS while reading the value is already pending and propagates
+         */
+        void ThrowTypeError() const;
+
+        CheckErrorCode  mCode;
+        int             mArgIndex;
+        int64_t         mElementIndex;
+        const char *    mProperty;
+        const char *    mCheck;
+        ArgType         mExpected;
+        ArgType         mActual;
+        int             mActualCount;
+        int             mExpectedCount[2];
+
+    private:
+        std::string Subject() const;
+    };
+
+    /**
+     * @brief Destination of a failed check: a message string, a failure record or nothing
+     */
+    class CheckReport
+    {
+    public:
+        CheckReport(std::string * error);
+        CheckReport(CheckFailure * failure);
+        CheckReport(std::nullptr_t);
+
+        /**
+         * Stores the failure and returns false
+         */
+        bool Fail(const CheckFailure& failure) const;
+
+    private:
+        std::string  * mError;
+        CheckFailure * mFailure;
+    };
+
     class CheckException : std::runtime_error
     {
     public:
@@ -45,9 +257,15 @@ namespace Nan
             return mMessage.c_str();
         }
 
+        const CheckFailure& Failure() const
+        {
+            return mFailure;
+        }
+
         virtual ~CheckException() = default;
     private:
-        std::string mMessage;
+        std::string  mMessage;
+        CheckFailure mFailure;
     };
 
     typedef std::function<bool(Nan::NAN_METHOD_ARGS_TYPE args) > InitFunction;
@@ -58,372 +276,4919 @@ namespace Nan
     template <typename EnumType>
     class ArgStringEnum;
 
+    template <typename T>
+    class ArgArrayElements;
+
+    class ArgProperty;
+
+    template <typename Record>
+    class ArgRecords;
+
+    class CheckSchema;
+    class SchemaBuilder;
+    class SchemaArgBinding;
+    class SchemaProperty;
+
+    template <typename EnumType>
+    class SchemaStringEnum;
+
     //////////////////////////////////////////////////////////////////////////
 
-    class CheckArguments
+    /**
+     * @brief Binds a value through Nan::Marshal, which reports failures by throwing
+     */
+    template <typename T>
+    struct MarshalBinder
+    {
+        static bool Bind(v8::Local<v8::Value> value, T& outValue);
+    };
+
+    /**
+     * @brief Binds numbers and booleans by reading the primitive directly, without Nan::Marshal or exceptions
+     */
+    template <typename T>
+    struct NumberBinder
+    {
+        static bool Bind(v8::Local<v8::Value> value, T& outValue);
+    };
+
+    /**
+     * @brief Converts a single JS value into a native variable.
+     *        Used by every Bind() call; specialize it to bind your own types.
+     *        Arithmetic types go through NumberBinder, everything else through Nan::Marshal.
+     */
+    template <typename T>
+    struct ArgBinder : std::conditional<std::is_arithmetic<T>::value, NumberBinder<T>, MarshalBinder<T> >::type
+    {
+    };
+
+    template <typename T>
+    struct ArgBinder< v8::Local<T> >
+    {
+        static bool Bind(v8::Local<v8::Value> value, v8::Local<T>& outValue);
+    };
+
+    /**
+     * @brief JS type reported as expected when binding of T fails
+     */
+    template <typename T>
+    struct ExpectedArgType
+    {
+        static const ArgType value = std::is_same<T, bool>::value ? ArgType::Boolean
+                                   : std::is_arithmetic<T>::value ? ArgType::Number
+                                   : ArgType::Unknown;
+    };
+
+    template <>
+    struct ExpectedArgType<std::string>
+    {
+        static const ArgType value = ArgType::String;
+    };
+
+    template <typename T>
+    struct ExpectedArgType< std::vector<T> >
+    {
+        static const ArgType value = ArgType::Array;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Unwraps a string or String object argument; returns false for anything else
+     */
+    bool StringArgument(v8::Local<v8::Value> value, v8::Local<v8::String>& outValue);
+
+    /**
+     * @brief UTF-8 length of str, or -1 when it exceeds maxLength. Strings whose UTF-16 length already
+     *        exceeds maxLength are rejected without scanning them.
+     */
+    ssize_t Utf8LengthWithin(v8::Local<v8::String> str, size_t maxLength);
+
+    /**
+     * @brief Whether the UTF-8 length of str is at most maxLength. Only strings whose UTF-16 length
+     *        falls between maxLength / 3 and maxLength are scanned.
+     */
+    bool Utf8FitsWithin(v8::Local<v8::String> str, size_t maxLength);
+
+    /**
+     * @brief Decodes UTF-8 into the bound string, reusing its capacity
+     */
+    template <>
+    struct ArgBinder<std::string>
+    {
+        static bool Bind(v8::Local<v8::Value> value, std::string& outValue);
+    };
+
+    /**
+     * @brief Zero-terminated UTF-8 string of at most Capacity bytes stored inline, e.g. on the stack.
+     *        Binding a longer string fails before anything is copied.
+     */
+    template <size_t Capacity>
+    class StringBuffer
     {
     public:
-        CheckArguments(Nan::NAN_METHOD_ARGS_TYPE args);
+        StringBuffer();
 
-        CheckArguments& ArgumentsCount(int count);
-        CheckArguments& ArgumentsCount(int argsCount1, int argsCount2);
+        const char * Data() const;
+        const char * c_str() const;
+        size_t Length() const;
 
-        MethodArgBinding Argument(int index);
+    private:
+        friend struct ArgBinder<StringBuffer>;
+
+        char    mData[Capacity + 1];
+        size_t  mLength;
+    };
+
+    template <size_t Capacity>
+    struct ArgBinder< StringBuffer<Capacity> >
+    {
+        static bool Bind(v8::Local<v8::Value> value, StringBuffer<Capacity>& outValue);
+    };
+
+    template <size_t Capacity>
+    struct ExpectedArgType< StringBuffer<Capacity> >
+    {
+        static const ArgType value = ArgType::String;
+    };
+
+    /**
+     * @brief Read-only view of a one-byte (Latin-1) string argument. External strings are viewed in place
+     *        without copying; other ones are copied into an inline buffer (or a reused heap one when longer).
+     *        Binding fails for strings with two-byte characters. Only valid during the call.
+     */
+    class OneByteString
+    {
+    public:
+        OneByteString();
+
+        const char * Data() const;
+        size_t Length() const;
 
         /**
-         * Unwind all fluent calls
+         * True when Data() points into the memory of the JS string
          */
-        operator bool() const;
-
-        CheckArguments& AddAndClause(InitFunction rightCondition);
-        CheckArguments& Error(std::string * error);
+        bool IsExternal() const;
 
     private:
-        Nan::NAN_METHOD_ARGS_TYPE m_args;
-        InitFunction          m_init;
-        std::string         * m_error;
+        friend struct ArgBinder<OneByteString>;
+
+        OneByteString(const OneByteString&);
+        OneByteString& operator=(const OneByteString&);
+
+        static const size_t kInlineCapacity = 64;
+
+        const char *    mData;
+        size_t          mLength;
+        bool            mExternal;
+        char            mInline[kInlineCapacity];
+        std::string     mHeap;
+    };
+
+    template <>
+    struct ArgBinder<OneByteString>
+    {
+        static bool Bind(v8::Local<v8::Value> value, OneByteString& outValue);
+    };
+
+    template <>
+    struct ExpectedArgType<OneByteString>
+    {
+        static const ArgType value = ArgType::String;
     };
 
     //////////////////////////////////////////////////////////////////////////
 
-    template <typename EnumType>
-    class ArgStringEnum
+    /**
+     * @brief Non-owning view of the memory behind a Buffer or TypedArray argument.
+     *        Only valid while the bound JS value is alive (i.e. during the call).
+     */
+    template <typename T>
+    class Span
     {
     public:
-        explicit ArgStringEnum(
-            std::initializer_list< std::pair<const char*, EnumType> > possibleValues,
-            MethodArgBinding& owner,
-            int argIndex);
+        Span();
+        Span(T * data, size_t length);
 
-        CheckArguments& Bind(EnumType& value);
-    protected:
+        T * Data() const;
+        size_t Length() const;
+        size_t ByteLength() const;
 
-        bool TryMatchStringEnum(const std::string& key, EnumType& outValue) const;
+        T& operator[](size_t index) const;
+
+        T * begin() const;
+        T * end() const;
 
     private:
-        std::map<std::string, EnumType>     mPossibleValues;
-        MethodArgBinding&                   mOwner;
-        int                                 mArgIndex;
+        T *     mData;
+        size_t  mLength;
+    };
+
+    /**
+     * @brief Which JS typed arrays may be viewed as a Span<T>.
+     *        Byte spans also accept node Buffers.
+     */
+    template <typename T>
+    struct TypedArrayTraits
+    {
+        static const bool kIsByte = false;
+        static bool IsInstance(v8::Local<v8::Value> value) { return false; }
+    };
+
+#if NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION
+#define NANCHECK_TYPED_ARRAY_TRAITS(type, isByte, check)                            \
+    template <>                                                                     \
+    struct TypedArrayTraits<type>                                                   \
+    {                                                                               \
+        static const bool kIsByte = isByte;                                         \
+        static bool IsInstance(v8::Local<v8::Value> value) { return check; }        \
+    };
+
+    NANCHECK_TYPED_ARRAY_TRAITS(char,       true,   value->IsInt8Array() || value->IsUint8Array() || value->IsUint8ClampedArray())
+    NANCHECK_TYPED_ARRAY_TRAITS(uint8_t,    true,   value->IsUint8Array() || value->IsUint8ClampedArray())
+    NANCHECK_TYPED_ARRAY_TRAITS(int8_t,     false,  value->IsInt8Array())
+    NANCHECK_TYPED_ARRAY_TRAITS(int16_t,    false,  value->IsInt16Array())
+    NANCHECK_TYPED_ARRAY_TRAITS(uint16_t,   false,  value->IsUint16Array())
+    NANCHECK_TYPED_ARRAY_TRAITS(int32_t,    false,  value->IsInt32Array())
+    NANCHECK_TYPED_ARRAY_TRAITS(uint32_t,   false,  value->IsUint32Array())
+    NANCHECK_TYPED_ARRAY_TRAITS(float,      false,  value->IsFloat32Array())
+    NANCHECK_TYPED_ARRAY_TRAITS(double,     false,  value->IsFloat64Array())
+
+#undef NANCHECK_TYPED_ARRAY_TRAITS
+#else
+    template <>
+    struct TypedArrayTraits<char>
+    {
+        static const bool kIsByte = true;
+        static bool IsInstance(v8::Local<v8::Value> value) { return false; }
+    };
+
+    template <>
+    struct TypedArrayTraits<uint8_t>
+    {
+        static const bool kIsByte = true;
+        static bool IsInstance(v8::Local<v8::Value> value) { return false; }
+    };
+#endif
+
+    /**
+     * @brief Binds a Buffer (byte spans) or a TypedArray of the exact element type without copying.
+     *        Offset views into a larger ArrayBuffer are honoured.
+     */
+    template <typename T>
+    struct ArgBinder< Span<T> >
+    {
+        static bool Bind(v8::Local<v8::Value> value, Span<T>& outValue);
+    };
+
+    template <typename T>
+    struct ExpectedArgType< Span<T> >
+    {
+        static const ArgType value = TypedArrayTraits<typename std::remove_const<T>::type>::kIsByte ? ArgType::Buffer : ArgType::TypedArray;
     };
 
     //////////////////////////////////////////////////////////////////////////
 
     /**
-     * @brief This class wraps particular positional argument
+     * @brief Converts a JS number to T, rejecting NaN, fractions and values out of T's range
+     *        for integral types
      */
-    class MethodArgBinding
+    template <typename T, bool IsIntegral = std::is_integral<T>::value>
+    struct NumberConverter
+    {
+        static bool Convert(double value, T& outValue);
+
+        /**
+         * Same for values V8 already holds as int32, which skips the integer-ness check
+         */
+        static bool Convert(int32_t value, T& outValue);
+    };
+
+    /**
+     * @brief Converts all elements of a JS array, or of a typed array passed in its place, into
+     *        the memory returned by allocate(length, T*&). Element types are validated in the same pass.
+     */
+    template <typename T, typename Allocate>
+    bool BindArrayElements(v8::Local<v8::Value> value, const Allocate& allocate);
+
+    /**
+     * @brief Binds arrays through BindArrayElements(); a reused vector keeps its capacity
+     */
+    template <typename T>
+    struct ArgBinder< std::vector<T> >
+    {
+        static bool Bind(v8::Local<v8::Value> value, std::vector<T>& outValue);
+    };
+
+    template <>
+    struct ArgBinder< std::vector<bool> > : MarshalBinder< std::vector<bool> >
+    {
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Cheap type check done when binding a Lazy<T>: matches the JS type of value against
+     *        ExpectedArgType<T> without converting it. Unknown expected types accept anything.
+     */
+    bool ArgTypeMatches(ArgType expected, v8::Local<v8::Value> value);
+
+    /**
+     * @brief Same check on ArgTrait bits, e.g. from an ArgumentFingerprint. Mirrors the binders:
+     *        string objects match strings, typed arrays match arrays and any object matches objects,
+     *        while numbers and booleans must be primitives.
+     */
+    bool ArgTypeMatches(ArgType expected, uint16_t traits);
+
+    /**
+     * @brief Deferred binding of an argument that is only needed on some code paths.
+     *        Binding stores the handle after a type check; the value is converted by ArgBinder<T>
+     *        on first access and cached. Only valid during the call.
+     */
+    template <typename T>
+    class Lazy
     {
     public:
+        Lazy();
 
-        template <typename EnumType>
-        friend class ArgStringEnum;
+        /**
+         * True once an argument has been bound
+         */
+        bool IsBound() const;
+
+        /**
+         * True once the argument has been converted, successfully or not
+         */
+        bool IsResolved() const;
+
+        /**
+         * Converts the argument on the first call; returns false and reports the failure if it cannot be converted
+         */
+        bool Resolve(const CheckReport& report = nullptr);
+
+        /**
+         * Converted value; throws CheckException if the argument cannot be converted
+         */
+        T& Get();
+
+        v8::Local<v8::Value> Handle() const;
+
+    private:
+        friend struct ArgBinder<Lazy>;
+        friend class MethodArgBinding;
+
+        Lazy(const Lazy&);
+        Lazy& operator=(const Lazy&);
+
+        enum State
+        {
+            Unbound,
+            Pending,
+            Converted,
+            Failed
+        };
+
+        v8::Local<v8::Value>    mHandle;
+        T                       mValue;
+        int                     mArgIndex;
+        State                   mState;
+    };
+
+    template <typename T>
+    struct ArgBinder< Lazy<T> >
+    {
+        static bool Bind(v8::Local<v8::Value> value, Lazy<T>& outValue);
+    };
+
+    template <typename T>
+    struct ExpectedArgType< Lazy<T> >
+    {
+        static const ArgType value = ExpectedArgType<T>::value;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    class IsolateContext;
+
+    /**
+     * @brief Internalized property keys, created once per isolate and kept as persistent handles.
+     *        Keys are identified by the content of their name, which the cache copies.
+     */
+    class PropertyKeyCache
+    {
+    public:
+        static v8::Local<v8::String> Get(const char * name);
+
+    private:
+        friend class IsolateContext;
+
+        struct Entry
+        {
+            std::string                     mName;
+            Nan::Persistent<v8::String>     mKey;
+        };
+
+        /**
+         * Name looked up without copying; keys in the map point into their Entry::mName
+         */
+        struct Name
+        {
+            const char *    mData;
+            size_t          mLength;
+
+            bool operator==(const Name& other) const;
+        };
+
+        struct NameHash
+        {
+            size_t operator()(const Name& name) const;
+        };
+
+        PropertyKeyCache();
+        ~PropertyKeyCache();
+
+        PropertyKeyCache(const PropertyKeyCache&);
+        PropertyKeyCache& operator=(const PropertyKeyCache&);
+
+        static PropertyKeyCache * Current();
+
+        std::unordered_map< Name, Entry *, NameHash >   mKeys;
+    };
+
+    v8::Local<v8::String> NewInternalizedString(const char * value);
+
+    /**
+     * @brief Name of an object property; Get() returns its cached internalized key
+     */
+    class PropertyKey
+    {
+    public:
+        explicit PropertyKey(const char * name);
+
+        const char * Name() const;
+        v8::Local<v8::String> Get() const;
+
+    private:
+        const char * mName;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Slots holding the callbacks of the current isolate. All slots live in one persistent array with a
+     *        free list of their indices, so that async methods neither allocate a callback nor create a
+     *        persistent handle per call. Slots are acquired and released on the isolate's thread.
+     */
+    class CallbackPool
+    {
+    public:
+        struct Stats
+        {
+            size_t  mSize;              // slots kept in the free list
+            size_t  mInUse;             // slots acquired and not released yet
+            size_t  mHighWaterMark;     // largest mInUse so far
+        };
+
+        /**
+         * Stores function in a free slot and returns the slot index
+         */
+        static int Acquire(v8::Local<v8::Function> function);
+        static void Assign(int slot, v8::Local<v8::Function> function);
+        static void Release(int slot);
+        static v8::Local<v8::Function> Get(int slot);
+
+        static Stats Statistics();
+
+    private:
+        friend class IsolateContext;
+
+        CallbackPool();
+        ~CallbackPool();
+
+        CallbackPool(const CallbackPool&);
+        CallbackPool& operator=(const CallbackPool&);
+
+        static CallbackPool * Current();
+
+        /**
+         * Sets a slot in the context the slots were created in; releasing may happen outside of any scope
+         */
+        void Store(int slot, v8::Local<v8::Value> value);
+
+        Nan::Persistent<v8::Array>      mSlots;
+        Nan::Persistent<v8::Context>    mContext;
+        int                             mSlotsCount;
+        std::vector<int>            mFree;
+        size_t                      mInUse;
+        size_t                      mHighWaterMark;
+    };
+
+    /**
+     * @brief Exported as a JS function, returns { size, inUse, highWaterMark } of the CallbackPool
+     */
+    NAN_METHOD(GetCallbackPoolStats);
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief State of nan-check kept per isolate, so that caches holding V8 handles are never shared between
+     *        isolates (e.g. worker threads). Created by the first Check in an isolate and destroyed by an
+     *        environment cleanup hook. Lookup from the isolate's thread is lock-free; only creation and
+     *        destruction take a lock.
+     */
+    class IsolateContext
+    {
+    public:
+        static IsolateContext * Current();
+        static IsolateContext * Current(v8::Isolate * isolate);
+
+        /**
+         * Number of live contexts
+         */
+        static size_t Count();
+
+        v8::Isolate * Isolate() const;
+
+        PropertyKeyCache& PropertyKeys();
+        CallbackPool& Callbacks();
+
+        /**
+         * Instance of T owned by this isolate, default-constructed on first use and destroyed with the context.
+         * Use it for caches of your own that hold V8 handles.
+         */
+        template <typename T>
+        T& Data();
+
+    private:
+        explicit IsolateContext(v8::Isolate * isolate);
+        ~IsolateContext();
+
+        IsolateContext(const IsolateContext&);
+        IsolateContext& operator=(const IsolateContext&);
+
+        struct Cached
+        {
+            v8::Isolate *       mIsolate;
+            IsolateContext *    mContext;
+            unsigned            mGeneration;
+        };
+
+        struct Registry
+        {
+            std::mutex                                              mLock;
+            std::unordered_map<v8::Isolate *, IsolateContext *>    mContexts;
+            std::atomic<unsigned>                                   mGeneration;
+        };
+
+        static IsolateContext * Lookup(v8::Isolate * isolate);
+        static void Destroy(void * context);
+
+        static Cached& ThreadCache();
+        static Registry& Contexts();
+
+        v8::Isolate *                                                   mIsolate;
+        PropertyKeyCache                                                mPropertyKeys;
+        CallbackPool                                                    mCallbacks;
+        std::vector< std::pair<const void *, std::shared_ptr<void> > > mData;
+    };
+
+    /**
+     * @brief Owns a slot of the CallbackPool holding a function, and returns it to the pool when destroyed.
+     *        Bind() a function argument to it; rebinding reuses the same slot.
+     */
+    class PooledCallback
+    {
+    public:
+        PooledCallback();
+        PooledCallback(PooledCallback&& other);
+        PooledCallback& operator=(PooledCallback&& other);
+        ~PooledCallback();
+
+        void Reset(v8::Local<v8::Function> function);
+        void Reset();
+
+        bool IsEmpty() const;
+        v8::Local<v8::Function> GetFunction() const;
+
+        /**
+         * Calls the function on the global object in the async context of resource, like Nan::Callback::Call
+         */
+        Nan::MaybeLocal<v8::Value> Call(int argc, v8::Local<v8::Value> argv[], Nan::AsyncResource * resource) const;
+
+    private:
+        PooledCallback(const PooledCallback&);
+        PooledCallback& operator=(const PooledCallback&);
+
+        int mSlot;
+    };
+
+    template <>
+    struct ArgBinder<PooledCallback>
+    {
+        static bool Bind(v8::Local<v8::Value> value, PooledCallback& outValue);
+    };
+
+    template <>
+    struct ExpectedArgType<PooledCallback>
+    {
+        static const ArgType value = ArgType::Function;
+    };
+
+    /**
+     * @brief AsyncWorker whose completion callback is a PooledCallback, returned to the pool when the worker
+     *        is destroyed. Base receives no callback, so completion handlers call mCallback instead of callback;
+     *        the default ones call it like Nan::AsyncWorker does.
+     */
+    template <typename Base = Nan::AsyncWorker>
+    class PooledCallbackWorker : public Base
+    {
+    public:
+        explicit PooledCallbackWorker(PooledCallback&& callback);
+
+    protected:
+        virtual void HandleOKCallback();
+        virtual void HandleErrorCallback();
+
+        PooledCallback mCallback;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief One property of a record schema, bound into a struct member or a column vector
+     */
+    struct RecordField
+    {
+        typedef bool(*BindFunction)(const RecordField& field, v8::Local<v8::Value> value, void * target, size_t index);
+        typedef void(*ResizeFunction)(const RecordField& field, void * target, size_t length);
+
+        const char *        mName;
+        ArgType             mExpected;
+        BindFunction        mBind;
+        ResizeFunction      mResize;
+
+        // Member pointer of the record type, stored without its type
+        char                mMember[2 * sizeof(void*)];
+    };
+
+    /**
+     * @brief Describes the properties of the objects in an array, so that a whole array of records
+     *        is validated and bound in one pass. Use Field() to bind into an array of Record structs,
+     *        or Column() to bind into a Record holding one vector per property (struct of arrays).
+     *        Build it once and keep it in a static.
+     */
+    template <typename Record>
+    class RecordSchema
+    {
+    public:
+        static const size_t kMaxFields = 32;
+
+        RecordSchema();
+
+        template <typename T>
+        RecordSchema& Field(const char * name, T Record::* member);
+
+        template <typename T>
+        RecordSchema& Column(const char * name, std::vector<T> Record::* column);
+
+        /**
+         * Binds every element of an array: prepare(length) returns false if the records do not fit,
+         * target(index) returns the Record the fields of the element are bound into.
+         * Stops at the first failure, reporting the element index and property in failure.
+         */
+        template <typename Prepare, typename Target>
+        bool BindElements(v8::Local<v8::Value> value, const Prepare& prepare, const Target& target, CheckFailure& failure) const;
+
+        bool HasColumns() const;
+        void ResizeColumns(Record& columns, size_t length) const;
+
+    private:
+        RecordField     mFields[kMaxFields];
+        size_t          mFieldsCount;
+        bool            mColumns;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+#if NANCHECK_ENABLE_METRICS
+    /**
+     * @brief Validation counters of a single method, updated without locks
+     */
+    struct MethodMetrics
+    {
+        static const int kArguments      = 16;  // failures of later arguments are counted under the last one
+        static const int kChecks         = 4;   // distinct failing checks tracked per argument
+        static const int kLatencyBuckets = 12;  // upper bounds 256ns, 512ns, ... and one unbounded bucket
+
+        std::atomic<const char *>   mName;
+        std::atomic<uint64_t>       mCalls;
+        std::atomic<uint64_t>       mFailures;
+        std::atomic<const char *>   mFailedCheck[kArguments + 1][kChecks];   // row 0 holds call-level failures
+        std::atomic<uint64_t>       mFailedCount[kArguments + 1][kChecks];
+        std::atomic<uint64_t>       mLatency[kLatencyBuckets];
+    };
+
+    /**
+     * @brief Fixed-size table of MethodMetrics keyed by method name. Names are compared by content, so
+     *        copies of a name share one slot; the first pointer seen for a name must outlive the table.
+     */
+    class CheckMetrics
+    {
+    public:
+        /**
+         * Returns the metrics of a method, claiming a slot on first use; nullptr when the table is full
+         */
+        static MethodMetrics * Find(const char * method);
+
+        static void Record(const char * method, const CheckFailure * failure, uint64_t nanoseconds);
+
+        /**
+         * Returns { method: { calls, failures, errors: [{ argument, check, count }], latency: { "<ns>": count } } }
+         */
+        static v8::Local<v8::Object> Snapshot();
+
+    private:
+        static MethodMetrics * Table();
+
+        static size_t Hash(const char * name);
+        static bool SameName(const char * a, const char * b);
+    };
+#endif
+
+    /**
+     * @brief Exported as a JS function, returns the CheckMetrics snapshot (undefined when metrics are disabled)
+     */
+    NAN_METHOD(GetCheckMetrics);
+
+    /**
+     * @brief Decides whether type checks run on a call. When they are skipped, ArgumentsCount and the
+     *        Is*()/NotNull() checks pass without looking at the arguments, while binding still happens
+     *        and still fails on values it cannot convert.
+     */
+    class CheckSampling
+    {
+    public:
+        /**
+         * Sets the process-wide rate used by checks without their own: 1 checks every call,
+         * N checks one call in N, 0 trusts the caller. Starts at NANCHECK_VALIDATION_SAMPLE_RATE.
+         */
+        static void SetRate(unsigned rate);
+        static unsigned Rate();
+
+        /**
+         * Returns whether the current call should be checked at the given rate; always true with NANCHECK_ALWAYS_VALIDATE
+         */
+        static bool Sample(unsigned rate);
+
+    private:
+        static std::atomic<unsigned>& GlobalRate();
+    };
+
+    class CheckArguments
+    {
+    public:
+        CheckArguments(Nan::NAN_METHOD_ARGS_TYPE args, const char * method = nullptr);
+
+        CheckArguments& ArgumentsCount(int count);
+        CheckArguments& ArgumentsCount(int argsCount1, int argsCount2);
+
+        MethodArgBinding Argument(int index);
+
+        /**
+         * Unwind all fluent calls
+         */
+        operator bool() const;
+
+        CheckArguments& AddAndClause(InitFunction rightCondition);
+        CheckArguments& Error(std::string * error);
+        CheckArguments& Failure(CheckFailure * failure);
+
+        /**
+         * Checks this method at its own rate instead of CheckSampling::Rate()
+         */
+        CheckArguments& Sampled(unsigned rate);
+
+        /**
+         * Skips type checks of this method; arguments are only bound
+         */
+        CheckArguments& Trusted();
+
+        /**
+         * Whether type checks run in the current evaluation
+         */
+        bool Validating() const;
+
+        /**
+         * Records the failure of a clause and returns false
+         */
+        bool Fail(const CheckFailure& failure);
+
+        /**
+         * Types of all arguments, classified once when evaluation starts
+         */
+        const ArgumentFingerprint& Fingerprint() const;
+
+        /**
+         * Fails a type check of an argument unless it has any of the given ArgTrait bits
+         */
+        bool Expect(int argIndex, uint16_t traits, const char * check, ArgType expected);
+
+    private:
+        bool Evaluate(CheckFailure& failure) const;
+
+        Nan::NAN_METHOD_ARGS_TYPE m_args;
+        InitFunction          m_init;
+        std::string         * m_error;
+        CheckFailure        * m_failureOut;
+        CheckFailure          m_failure;
+        mutable ArgumentFingerprint m_fingerprint;
+        int                   m_sampleRate;     // negative to follow CheckSampling::Rate()
+        mutable bool          m_validating;
+#if NANCHECK_ENABLE_METRICS
+        const char          * m_method;
+#endif
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Copies a JS string of at most maxLength UTF-8 bytes into a stack buffer
+     *        and calls match(key, length) on it. Longer strings are rejected without copying.
+     */
+    template <typename Matcher>
+    bool MatchStringKey(v8::Local<v8::Value> value, size_t maxLength, const Matcher& match);
+
+    /**
+     * @brief Table of allowed strings for a string enum argument. Build it once (e.g. as a static):
+     *        keys are stored contiguously and looked up through a collision-free hash,
+     *        so matching a JS string does not allocate.
+     */
+    template <typename EnumType>
+    class StringEnumTable
+    {
+    public:
+        StringEnumTable(std::initializer_list< std::pair<const char*, EnumType> > possibleValues);
+
+        bool Match(v8::Local<v8::Value> value, EnumType& outValue) const;
+        bool Match(const char * key, size_t length, EnumType& outValue) const;
+
+    private:
+        struct Entry
+        {
+            size_t      mOffset;
+            size_t      mLength;
+            EnumType    mValue;
+        };
+
+        static uint32_t Hash(const char * key, size_t length, uint32_t seed);
+        bool TryBuildSlots(uint32_t seed, size_t size);
+
+        std::vector<Entry>  mEntries;
+        std::string         mKeys;
+        std::vector<int>    mSlots;
+        uint32_t            mSeed;
+        size_t              mMaxLength;
+    };
+
+    template <typename EnumType>
+    class ArgStringEnum
+    {
+    public:
+        explicit ArgStringEnum(
+            std::initializer_list< std::pair<const char*, EnumType> > possibleValues,
+            MethodArgBinding& owner,
+            int argIndex);
+
+        explicit ArgStringEnum(
+            const StringEnumTable<EnumType>& table,
+            MethodArgBinding& owner,
+            int argIndex);
+
+        CheckArguments& Bind(EnumType& value);
+    protected:
+
+        bool TryMatchStringEnum(const std::string& key, EnumType& outValue) const;
+        bool TryMatchStringEnum(const char * key, size_t length, EnumType& outValue) const;
+
+    private:
+        struct Value
+        {
+            const char *    mName;
+            size_t          mLength;
+            EnumType        mValue;
+        };
+
+        static const size_t kInlineValues = 16;
+
+        const Value * Values() const;
+
+        Value                               mInlineValues[kInlineValues];
+        std::vector<Value>                  mOverflowValues;
+        size_t                              mValuesCount;
+        size_t                              mMaxLength;
+        const StringEnumTable<EnumType> *   mTable;
+        MethodArgBinding&                   mOwner;
+        int                                 mArgIndex;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Binds all elements of an array argument in one pass
+     */
+    template <typename T>
+    class ArgArrayElements
+    {
+    public:
+        ArgArrayElements(MethodArgBinding& owner, int argIndex);
+
+        /**
+         * Resizes values to the array length, reusing its capacity
+         */
+        CheckArguments& Bind(std::vector<T>& values);
+
+        /**
+         * Fills a caller-provided buffer; fails if the array does not fit
+         */
+        CheckArguments& Bind(Span<T> buffer, size_t& count);
+
+    private:
+        MethodArgBinding&   mOwner;
+        int                 mArgIndex;
+    };
+
+    /**
+     * @brief Binds a named property of an object argument
+     */
+    class ArgProperty
+    {
+    public:
+        ArgProperty(const char * name, MethodArgBinding& owner, int argIndex);
+
+        template <typename T>
+        CheckArguments& Bind(T& value);
+
+    private:
+        const char *        mName;
+        MethodArgBinding&   mOwner;
+        int                 mArgIndex;
+    };
+
+    /**
+     * @brief Binds an array argument whose elements are objects described by a RecordSchema
+     */
+    template <typename Record>
+    class ArgRecords
+    {
+    public:
+        ArgRecords(const RecordSchema<Record>& schema, MethodArgBinding& owner, int argIndex);
+
+        /**
+         * Array of structs; resizes records to the array length, reusing its capacity
+         */
+        CheckArguments& Bind(std::vector<Record>& records);
+
+        /**
+         * Array of structs in a caller-provided buffer; fails if the array does not fit
+         */
+        CheckArguments& Bind(Span<Record> buffer, size_t& count);
+
+        /**
+         * Struct of arrays; resizes every column of columns to the array length
+         */
+        CheckArguments& BindColumns(Record& columns, size_t& count);
+
+    private:
+        template <typename Prepare, typename Target>
+        CheckArguments& AddClause(const Prepare& prepare, const Target& target);
+
+        const RecordSchema<Record>& mSchema;
+        MethodArgBinding&           mOwner;
+        int                         mArgIndex;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief This class wraps particular positional argument
+     */
+    class MethodArgBinding
+    {
+    public:
+
+        template <typename EnumType>
+        friend class ArgStringEnum;
+
+        template <typename T>
+        friend class ArgArrayElements;
+
+        friend class ArgProperty;
+
+        template <typename Record>
+        friend class ArgRecords;
+
+        MethodArgBinding(int index, CheckArguments& parent);
+
+        MethodArgBinding& IsBuffer();
+        MethodArgBinding& IsFunction();
+        MethodArgBinding& IsString();
+        MethodArgBinding& NotNull();
+        MethodArgBinding& IsArray();
+        MethodArgBinding& IsObject();
+
+        /**
+         * Fails for strings longer than maxLength UTF-8 bytes, before they are bound
+         */
+        MethodArgBinding& MaxLength(size_t maxLength);
+
+        template <typename T>
+        ArgStringEnum<T> StringEnum(std::initializer_list< std::pair<const char*, T> > possibleValues);
+
+        template <typename T>
+        ArgStringEnum<T> StringEnum(const StringEnumTable<T>& table);
+
+        template <typename T>
+        ArgArrayElements<T> Elements();
+
+        ArgProperty Property(const char * name);
+        ArgProperty Property(const PropertyKey& key);
+
+        template <typename Record>
+        ArgRecords<Record> Records(const RecordSchema<Record>& schema);
+
+        template <typename T>
+        CheckArguments& Bind(v8::Local<T>& value);
+
+        template <typename T>
+        CheckArguments& Bind(T& value);
+
+        /**
+         * Type-checks the argument now and converts it when value is first accessed
+         */
+        template <typename T>
+        CheckArguments& Bind(Lazy<T>& value);
+
+        template <typename T1, typename T2>
+        CheckArguments& BindAny(T1& value1, T2& value2);
+
+    private:
+        int              mArgIndex;
+        CheckArguments&  mParent;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    struct SchemaClause;
+
+    typedef bool(*SchemaClauseFunction)(const SchemaClause& clause, v8::Local<v8::Value> value, void * target);
+
+    /**
+     * @brief Single step of a compiled schema: either an arguments count check
+     *        (argIndex < 0) or a check/binding of one positional argument.
+     */
+    struct SchemaClause
+    {
+        const char *                mName;
+        ArgType                     mExpected;
+        int                         mArgIndex;
+        int                         mCount1;
+        int                         mCount2;
+        int                         mSlot;
+        SchemaClauseFunction        mFunction;
+        std::shared_ptr<const void> mData;
+        const char *                mProperty;
+    };
+
+    /**
+     * @brief Fluent builder for CheckSchema. Mirrors the CheckArguments API, but Bind<T>()
+     *        declares a binding slot instead of capturing a variable.
+     */
+    class SchemaBuilder
+    {
+    public:
+        SchemaBuilder();
+
+        SchemaBuilder& ArgumentsCount(int count);
+        SchemaBuilder& ArgumentsCount(int argsCount1, int argsCount2);
+
+        SchemaArgBinding Argument(int index);
+
+        SchemaBuilder& AddClause(const SchemaClause& clause);
+
+        template <typename T>
+        SchemaBuilder& AddBinding(const SchemaClause& clause);
+
+    private:
+        friend class CheckSchema;
+
+        std::vector<SchemaClause>   mClauses;
+        std::vector<const void *>   mBindingTypes;
+    };
+
+    /**
+     * @brief Immutable validator compiled from a SchemaBuilder chain.
+     *        Declare it once (e.g. as a function-local static) and call Check() on every call:
+     *        evaluation runs the checks and writes into the given variables without allocating.
+     */
+    class CheckSchema
+    {
+    public:
+        CheckSchema(const SchemaBuilder& builder);
+
+        /**
+         * Validates args and binds them into targets, in the order of Bind<T>() declarations
+         */
+        template <typename... Targets>
+        bool Check(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Targets&... targets) const;
+
+        size_t BindingsCount() const;
+
+    private:
+        bool Evaluate(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report,
+                      void * const * targets, const void * const * types, size_t count) const;
+
+        std::vector<SchemaClause>   mClauses;
+        std::vector<const void *>   mBindingTypes;
+    };
+
+    /**
+     * @brief This class wraps particular positional argument of a schema
+     */
+    class SchemaArgBinding
+    {
+    public:
+        SchemaArgBinding(int index, SchemaBuilder& parent);
+
+        SchemaArgBinding& IsBuffer();
+        SchemaArgBinding& IsFunction();
+        SchemaArgBinding& IsString();
+        SchemaArgBinding& NotNull();
+        SchemaArgBinding& IsArray();
+        SchemaArgBinding& IsObject();
+        SchemaArgBinding& MaxLength(size_t maxLength);
+
+        template <typename T>
+        SchemaStringEnum<T> StringEnum(std::initializer_list< std::pair<const char*, T> > possibleValues);
+
+        template <typename T>
+        SchemaStringEnum<T> StringEnum(const StringEnumTable<T>& table);
+
+        SchemaProperty Property(const char * name);
+
+        template <typename T>
+        SchemaBuilder& Bind();
+
+    private:
+        SchemaArgBinding& AddCheck(const char * name, ArgType expected, SchemaClauseFunction check);
+
+        int              mArgIndex;
+        SchemaBuilder&   mParent;
+    };
+
+    template <typename EnumType>
+    class SchemaStringEnum
+    {
+    public:
+        SchemaStringEnum(
+            std::shared_ptr< const StringEnumTable<EnumType> > table,
+            SchemaBuilder& parent,
+            int argIndex);
+
+        SchemaBuilder& Bind();
+
+    private:
+        std::shared_ptr< const StringEnumTable<EnumType> >      mTable;
+        SchemaBuilder&                                          mParent;
+        int                                                     mArgIndex;
+    };
+
+    /**
+     * @brief Binds a named property of an object argument of a schema
+     */
+    class SchemaProperty
+    {
+    public:
+        SchemaProperty(const char * name, SchemaBuilder& parent, int argIndex);
+
+        template <typename T>
+        SchemaBuilder& Bind();
+
+    private:
+        const char *     mName;
+        SchemaBuilder&   mParent;
+        int              mArgIndex;
+    };
+
+    SchemaBuilder Schema();
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Returns the table used by Arg::Enum<EnumType> in signatures.
+     *        Specialize it for every enum type used in a Signature.
+     */
+    template <typename EnumType>
+    const StringEnumTable<EnumType>& StringEnumValues();
+
+    /**
+     * @brief Tag types for Signature that check the JS type of an argument
+     *        and bind it to a handle. Any other type is bound through ArgBinder.
+     */
+    namespace Arg
+    {
+        struct Buffer;
+        struct Function;
+        struct String;
+        struct Array;
+        struct Object;
+
+        template <typename EnumType>
+        struct Enum;
+    }
+
+    /**
+     * @brief Describes how a single Signature argument is checked and bound
+     */
+    template <typename T>
+    struct SignatureArg
+    {
+        typedef T Type;
+
+        static const char * Name() { return "Bind"; }
+        static ArgType Expected() { return ExpectedArgType<T>::value; }
+        static CheckErrorCode Code() { return CheckErrorCode::Bind; }
+        static bool Accepts(uint16_t traits) { return ArgTypeMatches(Expected(), traits); }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue) { return ArgBinder<T>::Bind(value, outValue); }
+    };
+
+    template <>
+    struct SignatureArg<Arg::Buffer>
+    {
+        typedef v8::Local<v8::Object> Type;
+
+        static const char * Name() { return "IsBuffer"; }
+        static ArgType Expected() { return ArgType::Buffer; }
+        static CheckErrorCode Code() { return CheckErrorCode::Check; }
+        static bool Accepts(uint16_t traits) { return (traits & (ArgTrait::Buffer)) != 0; }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue);
+    };
+
+    template <>
+    struct SignatureArg<Arg::Function>
+    {
+        typedef v8::Local<v8::Function> Type;
+
+        static const char * Name() { return "IsFunction"; }
+        static ArgType Expected() { return ArgType::Function; }
+        static CheckErrorCode Code() { return CheckErrorCode::Check; }
+        static bool Accepts(uint16_t traits) { return (traits & (ArgTrait::Function)) != 0; }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue);
+    };
+
+    template <>
+    struct SignatureArg<Arg::String>
+    {
+        typedef v8::Local<v8::String> Type;
+
+        static const char * Name() { return "IsString"; }
+        static ArgType Expected() { return ArgType::String; }
+        static CheckErrorCode Code() { return CheckErrorCode::Check; }
+        static bool Accepts(uint16_t traits) { return (traits & (ArgTrait::String | ArgTrait::StringObject)) != 0; }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue);
+    };
+
+    template <>
+    struct SignatureArg<Arg::Array>
+    {
+        typedef v8::Local<v8::Array> Type;
+
+        static const char * Name() { return "IsArray"; }
+        static ArgType Expected() { return ArgType::Array; }
+        static CheckErrorCode Code() { return CheckErrorCode::Check; }
+        static bool Accepts(uint16_t traits) { return (traits & (ArgTrait::Array)) != 0; }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue);
+    };
+
+    template <>
+    struct SignatureArg<Arg::Object>
+    {
+        typedef v8::Local<v8::Object> Type;
+
+        static const char * Name() { return "IsObject"; }
+        static ArgType Expected() { return ArgType::Object; }
+        static CheckErrorCode Code() { return CheckErrorCode::Check; }
+        static bool Accepts(uint16_t traits) { return (traits & (ArgTrait::Object)) != 0; }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue);
+    };
+
+    template <typename EnumType>
+    struct SignatureArg< Arg::Enum<EnumType> >
+    {
+        typedef EnumType Type;
+
+        static const char * Name() { return "StringEnum"; }
+        static ArgType Expected() { return ArgType::String; }
+        static CheckErrorCode Code() { return CheckErrorCode::Bind; }
+        static bool Accepts(uint16_t traits) { return (traits & (ArgTrait::String | ArgTrait::StringObject)) != 0; }
+        static bool Bind(v8::Local<v8::Value> value, Type& outValue);
+    };
+
+    template <size_t... Indices>
+    struct IndexSequence
+    {
+    };
+
+    template <size_t N, size_t... Indices>
+    struct MakeIndexSequence : MakeIndexSequence<N - 1, N - 1, Indices...>
+    {
+    };
+
+    template <size_t... Indices>
+    struct MakeIndexSequence<0, Indices...>
+    {
+        typedef IndexSequence<Indices...> Type;
+    };
+
+    template <typename... Args>
+    class WorkerPayload;
+
+    /**
+     * @brief Compile-time alternative to CheckArguments.
+     *        Signature<Arg::Buffer, uint32_t, Arg::Enum<PatternType>, Arg::Function> expands
+     *        into inlined checks of exactly four arguments without any std::function indirection.
+     */
+    template <typename... Args>
+    class Signature
+    {
+    public:
+        typedef std::tuple< typename SignatureArg<Args>::Type... > Values;
+        typedef WorkerPayload<Args...> Payload;
+
+        static const int Arity = sizeof...(Args);
+
+        /**
+         * JS types expected for each of the Arity arguments
+         */
+        static const ArgType * ExpectedTypes();
+
+        /**
+         * Whether arguments of these types would pass SignatureArg<Args>::Bind, judged from their traits only
+         */
+        static bool Accepts(const ArgumentFingerprint& fingerprint);
+
+        static bool Check(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, typename SignatureArg<Args>::Type&... values);
+        static bool Check(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Values& values);
+
+        /**
+         * Checks arguments, captures them into a Payload, and queues new Worker(std::move(payload)).
+         * Buffers and typed arrays are pinned on the worker's persistent handle.
+         */
+        template <typename Worker>
+        static bool QueueAs(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report);
+
+    private:
+        template <size_t... Indices>
+        static bool Accepts(const ArgumentFingerprint& fingerprint, IndexSequence<Indices...>);
+
+        template <typename Worker, size_t... Indices>
+        static void Pin(Worker * worker, Nan::NAN_METHOD_ARGS_TYPE args, IndexSequence<Indices...>);
+
+        template <typename Tuple, size_t... Indices>
+        static bool Evaluate(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Tuple values, IndexSequence<Indices...>);
+
+        static bool Fail(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, int argIndex);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    struct IsLocalHandle : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct IsLocalHandle< v8::Local<T> > : std::true_type
+    {
+    };
+
+    /**
+     * @brief Describes how a bound Signature argument is captured into a WorkerPayload.
+     *        By default the bound value is copied. Capture receives the StorageSize computed for the same value.
+     */
+    template <typename T>
+    struct PayloadArg
+    {
+        typedef typename SignatureArg<T>::Type Type;
+
+        static_assert(!IsLocalHandle<Type>::value, "JS handles can not be captured into a worker payload");
+
+        static const bool kPinned = false;
+
+        static size_t StorageSize(const typename SignatureArg<T>::Type& bound) { return 0; }
+        static void Capture(const typename SignatureArg<T>::Type& bound, size_t size, char *& storage, Type& outValue) { outValue = bound; }
+    };
+
+    /**
+     * @brief Buffers are captured as a byte view of their data; the buffer object itself is pinned
+     */
+    template <>
+    struct PayloadArg<Arg::Buffer>
+    {
+        typedef Span<char> Type;
+
+        static const bool kPinned = true;
+
+        static size_t StorageSize(const v8::Local<v8::Object>& bound) { return 0; }
+        static void Capture(const v8::Local<v8::Object>& bound, size_t size, char *& storage, Type& outValue);
+    };
+
+    template <typename T>
+    struct PayloadArg< Span<T> >
+    {
+        typedef Span<T> Type;
+
+        static const bool kPinned = true;
+
+        static size_t StorageSize(const Span<T>& bound) { return 0; }
+        static void Capture(const Span<T>& bound, size_t size, char *& storage, Type& outValue) { outValue = bound; }
+    };
+
+    /**
+     * @brief Strings are copied as UTF-8 into storage shared by all strings of a payload.
+     *        The view excludes the terminating zero that follows it.
+     */
+    template <>
+    struct PayloadArg<Arg::String>
+    {
+        typedef Span<const char> Type;
+
+        static const bool kPinned = false;
+
+        static size_t StorageSize(const v8::Local<v8::String>& bound);
+        static void Capture(const v8::Local<v8::String>& bound, size_t size, char *& storage, Type& outValue);
+    };
+
+    template <>
+    struct PayloadArg<Arg::Function>
+    {
+        typedef std::unique_ptr<Nan::Callback> Type;
+
+        static const bool kPinned = false;
+
+        static size_t StorageSize(const v8::Local<v8::Function>& bound) { return 0; }
+        static void Capture(const v8::Local<v8::Function>& bound, size_t size, char *& storage, Type& outValue) { outValue.reset(new Nan::Callback(bound)); }
+    };
+
+    /**
+     * @brief Index of the last Arg::Function in Args, or -1
+     */
+    template <int Index, int Found, typename... Args>
+    struct LastFunctionIndex
+    {
+        static const int value = Found;
+    };
+
+    template <int Index, int Found, typename Head, typename... Tail>
+    struct LastFunctionIndex<Index, Found, Head, Tail...>
+        : LastFunctionIndex<Index + 1, std::is_same<Head, Arg::Function>::value ? Index : Found, Tail...>
+    {
+    };
+
+    /**
+     * @brief Self-contained copy of arguments checked by Signature<Args...>, safe to use from a worker thread.
+     *        Scalars are copied, buffers are viewed in place, strings share one allocation and callbacks
+     *        are wrapped into Nan::Callback. Must be destroyed on the main thread.
+     */
+    template <typename... Args>
+    class WorkerPayload
+    {
+    public:
+        typedef std::tuple< typename PayloadArg<Args>::Type... > Values;
+
+        /**
+         * The last Arg::Function of the signature, handed over to the worker as its completion callback
+         */
+        static const int kCompletion = LastFunctionIndex<0, -1, Args...>::value;
+
+        WorkerPayload();
+        explicit WorkerPayload(const typename Signature<Args...>::Values& bound);
+
+        WorkerPayload(WorkerPayload&& other);
+        WorkerPayload& operator=(WorkerPayload&& other);
+
+        template <size_t Index>
+        typename std::tuple_element<Index, Values>::type& Get();
+
+        template <size_t Index>
+        const typename std::tuple_element<Index, Values>::type& Get() const;
+
+        Nan::Callback * ReleaseCompletion();
+
+    private:
+        template <size_t... Indices>
+        void Capture(const typename Signature<Args...>::Values& bound, IndexSequence<Indices...>);
+
+        Values                  mValues;
+        std::unique_ptr<char[]> mStrings;
+    };
+
+    /**
+     * @brief Base for workers queued with Signature::QueueAs. Base is Nan::AsyncWorker or Nan::AsyncProgressWorker.
+     */
+    template <typename SignatureType, typename Base = Nan::AsyncWorker>
+    class PayloadWorker : public Base
+    {
+    public:
+        typedef typename SignatureType::Payload Payload;
+
+        explicit PayloadWorker(Payload&& payload);
+
+    protected:
+        Payload mPayload;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Whether an argument of the actual type may bind to the expected one.
+     *        Unknown accepts anything, leaving the decision to the binding itself.
+     */
+    bool ArgTypeAccepts(ArgType expected, ArgType actual);
+
+    template <int... Values>
+    struct MaxValue
+    {
+        static const int value = 0;
+    };
+
+    template <int Head, int... Tail>
+    struct MaxValue<Head, Tail...>
+    {
+        static const int value = Head > MaxValue<Tail...>::value ? Head : MaxValue<Tail...>::value;
+    };
+
+    /**
+     * @brief Dispatches a call to the first of several Signature types whose arity and argument types match.
+     *        Arguments are classified once; only the selected signature binds them, and a single failure
+     *        listing all overloads is reported when none matches:
+     *
+     *        Overloads< Signature<Arg::Buffer, uint32_t, Arg::Function>, Signature<Arg::Object, Arg::Function> >
+     *            ::Dispatch(info, &error,
+     *                [&](v8::Local<v8::Object> buffer, uint32_t width, v8::Local<v8::Function> cb) { ... },
+     *                [&](v8::Local<v8::Object> options, v8::Local<v8::Function> cb) { ... });
+     */
+    template <typename... Signatures>
+    class Overloads
+    {
+    public:
+        static const int Count = sizeof...(Signatures);
+        static const int MaxArity = MaxValue<Signatures::Arity...>::value;
+
+        /**
+         * Index of the overload matching the arguments, or -1
+         */
+        static int Select(Nan::NAN_METHOD_ARGS_TYPE args);
+
+        /**
+         * Binds the arguments of the selected overload and calls the handler at the same index with them
+         */
+        template <typename... Handlers>
+        static bool Dispatch(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handlers&&... handlers);
+
+        /**
+         * Expected types of all overloads, e.g. "(buffer, number, function) or (object, function)"
+         */
+        static const char * Description();
+
+    private:
+        template <typename Handlers>
+        static bool Invoke(int selected, Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handlers& handlers, std::integral_constant<size_t, sizeof...(Signatures)>);
+
+        template <typename Handlers, size_t Index>
+        static bool Invoke(int selected, Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handlers& handlers, std::integral_constant<size_t, Index>);
+
+        template <typename SignatureType, typename Handler, size_t... Indices>
+        static bool Call(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handler& handler, IndexSequence<Indices...>);
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Common part of FastMethod; Derived::Call(receiver, args...) calls the native function
+     */
+    template <typename Derived, typename R, typename... Args>
+    class FastMethodBase
+    {
+    public:
+        typedef Signature<Args...> SignatureType;
+
+        static const int Arity = sizeof...(Args);
+
+        /**
+         * Checks the arguments against SignatureType, throwing its TypeError on failure, and calls the function
+         */
+        static NAN_METHOD(Method);
+
+        /**
+         * Function template calling Method
+         */
+        static v8::Local<v8::FunctionTemplate> Template();
+
+    private:
+        template <size_t... Indices>
+        static void Invoke(Nan::NAN_METHOD_ARGS_TYPE info, IndexSequence<Indices...>);
+
+        template <size_t... Indices>
+        static void Return(Nan::NAN_METHOD_ARGS_TYPE info, typename SignatureType::Values& values, IndexSequence<Indices...>, std::false_type);
+
+        template <size_t... Indices>
+        static void Return(Nan::NAN_METHOD_ARGS_TYPE info, typename SignatureType::Values& values, IndexSequence<Indices...>, std::true_type);
+    };
+
+    /**
+     * @brief Registers a plain native function as a callback checked like Signature<Args...>:
+     *
+     *        double Add(double a, double b) { return a + b; }
+     *        Nan::Set(target, Nan::New("add").ToLocalChecked(),
+     *                 Nan::GetFunction(NANCHECK_FAST_METHOD(Add)::Template()).ToLocalChecked());
+     *
+     *        Parameters are any types Signature binds, taken by value; a leading v8::Local<v8::Object>
+     *        parameter receives `this`. The result is returned to JS unless the function returns void.
+     */
+    template <typename Function, Function function>
+    class FastMethod;
+
+    template <typename R, typename... Args, R (*function)(Args...)>
+    class FastMethod<R (*)(Args...), function> : public FastMethodBase<FastMethod<R (*)(Args...), function>, R, Args...>
+    {
+    public:
+        static R Call(v8::Local<v8::Object> receiver, Args... args) { return function(args...); }
+    };
+
+    template <typename R, typename... Args, R (*function)(v8::Local<v8::Object>, Args...)>
+    class FastMethod<R (*)(v8::Local<v8::Object>, Args...), function>
+        : public FastMethodBase<FastMethod<R (*)(v8::Local<v8::Object>, Args...), function>, R, Args...>
+    {
+    public:
+        static R Call(v8::Local<v8::Object> receiver, Args... args) { return function(receiver, args...); }
+    };
+
+#define NANCHECK_FAST_METHOD(function) Nan::FastMethod<decltype(&function), &function>
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Bounded lock-free FIFO for exactly one producer and one consumer thread
+     */
+    template <typename T, size_t Capacity>
+    class ProgressRing
+    {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "ProgressRing capacity must be a power of two");
+
+    public:
+        ProgressRing();
+
+        /**
+         * Producer side; returns false when the ring is full
+         */
+        bool Push(const T& value);
+
+        /**
+         * Consumer side; moves up to maxCount values in FIFO order into values and returns their count
+         */
+        size_t Pop(T * values, size_t maxCount);
+
+    private:
+        // Head and tail live on separate cache lines so that both threads do not fight over one
+        std::atomic<size_t>     mHead;
+        char                    mHeadPadding[64 - sizeof(std::atomic<size_t>)];
+        std::atomic<size_t>     mTail;
+        char                    mTailPadding[64 - sizeof(std::atomic<size_t>)];
+        T                       mValues[Capacity];
+    };
+
+    enum class ProgressCoalescing
+    {
+        Latest,     // only the newest update since the last callback
+        Batch,      // every update since the last callback
+        Throttle    // every update, waking the event loop at most once per interval
+    };
+
+    /**
+     * @brief How updates sent from a worker thread are coalesced into JS callbacks
+     */
+    struct ProgressPolicy
+    {
+        ProgressCoalescing  mMode;
+        unsigned            mIntervalMs;
+
+        static ProgressPolicy Latest();
+        static ProgressPolicy Batch();
+        static ProgressPolicy Throttle(unsigned intervalMs);
+    };
+
+    /**
+     * @brief AsyncWorker that reports typed progress through a ProgressRing. Send() neither allocates nor locks,
+     *        the event loop is woken at most once per pending batch, and all updates received since the last
+     *        callback are delivered in one HandleProgressCallback(values, count) call, in order.
+     *        When the ring is full, the newest overflowing update is kept and the others are counted by Dropped().
+     *        Remaining updates are always delivered before the completion callback.
+     */
+    template <typename T, size_t Capacity = 1024>
+    class AsyncBatchProgressWorker : public Nan::AsyncWorker
+    {
+    public:
+        class ExecutionProgress
+        {
+            friend class AsyncBatchProgressWorker;
+
+        public:
+            void Send(const T& value) const;
+
+        private:
+            explicit ExecutionProgress(AsyncBatchProgressWorker * worker);
+
+            AsyncBatchProgressWorker * const mWorker;
+        };
+
+        AsyncBatchProgressWorker(Nan::Callback * callback, ProgressPolicy policy);
+        virtual ~AsyncBatchProgressWorker();
+
+        virtual void Execute(const ExecutionProgress& progress) = 0;
+        virtual void HandleProgressCallback(const T * values, size_t count) = 0;
+
+        virtual void WorkComplete();
+        virtual void Destroy();
+
+        /**
+         * Number of updates lost because the ring was full
+         */
+        uint64_t Dropped() const;
+
+    private:
+        virtual void Execute();
+
+        void Send(const T& value);
+        void Deliver();
+
+        static NAUV_WORK_CB(AsyncProgress);
+        static void AsyncClose(uv_handle_t * handle);
+
+        typedef std::chrono::steady_clock Clock;
+
+        ProgressRing<T, Capacity>   mRing;
+        ProgressPolicy              mPolicy;
+        uv_async_t *                mAsync;
+        std::atomic<bool>           mWakePending;
+        std::atomic<uint64_t>       mDropped;
+        std::unique_ptr<T[]>        mBatch;
+
+        // Owned by the producer thread
+        Clock::time_point           mLastWake;
+        T                           mOverflow;
+        bool                        mHasOverflow;
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    // Template functions implementation
+
+    template <typename T>
+    inline CheckArguments& MethodArgBinding::Bind(v8::Local<T>& value)
+    {
+        return mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
+            return ArgBinder< v8::Local<T> >::Bind(args[mArgIndex], value);
+        });
+    }
+
+
+    template <typename T>
+    inline CheckArguments& MethodArgBinding::Bind(T& value)
+    {
+        return mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
+            if (!ArgBinder<T>::Bind(args[mArgIndex], value))
+                return mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Bind", ExpectedArgType<T>::value, args[mArgIndex]));
+
+            return true;
+        });
+    }
+
+    template <typename T>
+    inline CheckArguments& MethodArgBinding::Bind(Lazy<T>& value)
+    {
+        return mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
+            if (!mParent.Validating())
+            {
+                value.mHandle = args[mArgIndex];
+                value.mState = Lazy<T>::Pending;
+            }
+            else if (!ArgBinder< Lazy<T> >::Bind(args[mArgIndex], value))
+            {
+                return mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Bind", ExpectedArgType<T>::value, args[mArgIndex]));
+            }
+
+            value.mArgIndex = mArgIndex;
+            return true;
+        });
+    }
+
+    template <typename T1, typename T2>
+    inline CheckArguments& MethodArgBinding::BindAny(T1& value1, T2& value2)
+    {
+        return mParent.AddAndClause([this, &value1, &value2](Nan::NAN_METHOD_ARGS_TYPE args) {
+            if (!ArgBinder<T1>::Bind(args[mArgIndex], value1))
+                return mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Bind", ExpectedArgType<T1>::value, args[mArgIndex]));
+
+            if (!ArgBinder<T2>::Bind(args[mArgIndex], value2))
+                return mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Bind", ExpectedArgType<T2>::value, args[mArgIndex]));
+
+            return true;
+        });
+    }
+
+    template <typename T>
+    inline ArgStringEnum<T> MethodArgBinding::StringEnum(std::initializer_list< std::pair<const char*, T> > possibleValues)
+    {
+        return std::move(ArgStringEnum<T>(possibleValues, IsString(), mArgIndex));
+    }
+
+    template <typename T>
+    inline ArgStringEnum<T> MethodArgBinding::StringEnum(const StringEnumTable<T>& table)
+    {
+        return std::move(ArgStringEnum<T>(table, IsString(), mArgIndex));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename Matcher>
+    inline bool MatchStringKey(v8::Local<v8::Value> value, size_t maxLength, const Matcher& match)
+    {
+        static const size_t kStackKeyCapacity = 256;
+
+        v8::Local<v8::String> str;
+        if (!StringArgument(value, str))
+            return false;
+
+        ssize_t length = Utf8LengthWithin(str, maxLength);
+        if (length < 0)
+            return false;
+
+        if (maxLength < kStackKeyCapacity)
+        {
+            char key[kStackKeyCapacity];
+            Nan::DecodeWrite(key, length, str, Nan::UTF8);
+            return match(key, static_cast<size_t>(length));
+        }
+
+        std::vector<char> key(length + 1);
+        Nan::DecodeWrite(key.data(), length, str, Nan::UTF8);
+        return match(key.data(), static_cast<size_t>(length));
+    }
+
+    template <typename T>
+    inline ArgStringEnum<T>::ArgStringEnum(
+        std::initializer_list< std::pair<const char*, T> > possibleValues,
+        MethodArgBinding& owner, int argIndex)
+        : mInlineValues()
+        , mValuesCount(possibleValues.size())
+        , mMaxLength(0)
+        , mTable(nullptr)
+        , mOwner(owner)
+        , mArgIndex(argIndex)
+    {
+        // The initializer list may not outlive this call, so keep a copy of the (few) values
+        if (mValuesCount > kInlineValues)
+            mOverflowValues.resize(mValuesCount);
+
+        Value * values = mOverflowValues.empty() ? mInlineValues : mOverflowValues.data();
+        for (const std::pair<const char*, T>& value : possibleValues)
+        {
+            values->mName = value.first;
+            values->mLength = std::strlen(value.first);
+            values->mValue = value.second;
+            mMaxLength = std::max(mMaxLength, values->mLength);
+            values++;
+        }
+    }
+
+    template <typename T>
+    inline ArgStringEnum<T>::ArgStringEnum(
+        const StringEnumTable<T>& table,
+        MethodArgBinding& owner, int argIndex)
+        : mInlineValues()
+        , mValuesCount(0)
+        , mMaxLength(0)
+        , mTable(&table)
+        , mOwner(owner)
+        , mArgIndex(argIndex)
+    {
+    }
+
+    template <typename T>
+    inline CheckArguments& ArgStringEnum<T>::Bind(T& value)
+    {
+        return mOwner.mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
+            bool matched = mTable ? mTable->Match(args[mArgIndex], value)
+                                  : MatchStringKey(args[mArgIndex], mMaxLength, [this, &value](const char * key, size_t length) {
+                                        return TryMatchStringEnum(key, length, value);
+                                    });
+            if (!matched)
+                return mOwner.mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "StringEnum", ArgType::String, args[mArgIndex]));
+
+            return true;
+        });
+    }
+
+    template <typename T>
+    inline bool ArgStringEnum<T>::TryMatchStringEnum(const std::string& key, T& outValue) const
+    {
+        return TryMatchStringEnum(key.data(), key.size(), outValue);
+    }
+
+    template <typename T>
+    inline bool ArgStringEnum<T>::TryMatchStringEnum(const char * key, size_t length, T& outValue) const
+    {
+        if (mTable)
+            return mTable->Match(key, length, outValue);
+
+        const Value * values = Values();
+        for (size_t i = 0; i < mValuesCount; i++)
+        {
+            // Keys may contain NUL characters, so compare whole lengths rather than C strings
+            if (values[i].mLength == length && std::memcmp(values[i].mName, key, length) == 0)
+            {
+                outValue = values[i].mValue;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template <typename T>
+    inline const typename ArgStringEnum<T>::Value * ArgStringEnum<T>::Values() const
+    {
+        return mOverflowValues.empty() ? mInlineValues : mOverflowValues.data();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    inline ArgArrayElements<T> MethodArgBinding::Elements()
+    {
+        return ArgArrayElements<T>(*this, mArgIndex);
+    }
+
+    template <typename T>
+    inline ArgArrayElements<T>::ArgArrayElements(MethodArgBinding& owner, int argIndex)
+        : mOwner(owner)
+        , mArgIndex(argIndex)
+    {
+    }
+
+    template <typename T>
+    inline CheckArguments& ArgArrayElements<T>::Bind(std::vector<T>& values)
+    {
+        return mOwner.mParent.AddAndClause([this, &values](Nan::NAN_METHOD_ARGS_TYPE args) {
+            if (!ArgBinder< std::vector<T> >::Bind(args[mArgIndex], values))
+                return mOwner.mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Elements", ArgType::Array, args[mArgIndex]));
+
+            return true;
+        });
+    }
+
+    template <typename T>
+    inline CheckArguments& ArgArrayElements<T>::Bind(Span<T> buffer, size_t& count)
+    {
+        return mOwner.mParent.AddAndClause([this, buffer, &count](Nan::NAN_METHOD_ARGS_TYPE args) {
+            bool bound = BindArrayElements<T>(args[mArgIndex], [buffer, &count](size_t length, T *& out) {
+                count = length;
+                out = buffer.Data();
+                return length <= buffer.Length();
+            });
+
+            if (!bound)
+                return mOwner.mParent.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Elements", ArgType::Array, args[mArgIndex]));
+
+            return true;
+        });
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Reads a property of an object argument through the cached key and binds it
+     */
+    template <typename T>
+    inline bool BindProperty(v8::Local<v8::Value> object, const char * name, T& outValue, v8::Local<v8::Value>& property)
+    {
+        property = object;
+        if (!object->IsObject())
+            return false;
+
+        return Nan::Get(object.As<v8::Object>(), PropertyKeyCache::Get(name)).ToLocal(&property) &&
+               ArgBinder<T>::Bind(property, outValue);
+    }
+
+    template <typename T>
+    inline CheckArguments& ArgProperty::Bind(T& value)
+    {
+        return mOwner.mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
+            v8::Local<v8::Value> property;
+            if (!BindProperty(args[mArgIndex], mName, value, property))
+            {
+                // An empty property means its getter threw
+                CheckFailure failure = property.IsEmpty()
+                    ? CheckFailure::Violation(CheckErrorCode::Exception, mArgIndex, "Property", ExpectedArgType<T>::value, ArgType::Unknown)
+                    : CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Property", ExpectedArgType<T>::value, property);
+                failure.mProperty = mName;
+                return mOwner.mParent.Fail(failure);
+            }
+
+            return true;
+        });
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename Record, typename T>
+    inline bool BindRecordField(const RecordField& field, v8::Local<v8::Value> value, void * target, size_t)
+    {
+        T Record::* member;
+        memcpy(&member, field.mMember, sizeof(member));
+        return ArgBinder<T>::Bind(value, static_cast<Record*>(target)->*member);
+    }
+
+    template <typename Record, typename T>
+    inline bool BindRecordColumn(const RecordField& field, v8::Local<v8::Value> value, void * target, size_t index)
+    {
+        std::vector<T> Record::* column;
+        memcpy(&column, field.mMember, sizeof(column));
+
+        // Bound through a temporary, since std::vector<bool> has no addressable elements
+        T item;
+        if (!ArgBinder<T>::Bind(value, item))
+            return false;
+
+        (static_cast<Record*>(target)->*column)[index] = std::move(item);
+        return true;
+    }
+
+    template <typename Record, typename T>
+    inline void ResizeRecordColumn(const RecordField& field, void * target, size_t length)
+    {
+        std::vector<T> Record::* column;
+        memcpy(&column, field.mMember, sizeof(column));
+        (static_cast<Record*>(target)->*column).resize(length);
+    }
+
+    template <typename Record>
+    inline RecordSchema<Record>::RecordSchema()
+        : mFieldsCount(0)
+        , mColumns(false)
+    {
+    }
+
+    template <typename Record>
+    template <typename T>
+    inline RecordSchema<Record>& RecordSchema<Record>::Field(const char * name, T Record::* member)
+    {
+        static_assert(sizeof(member) <= sizeof(RecordField::mMember), "Member pointer does not fit into RecordField");
+        assert(mFieldsCount < kMaxFields && !mColumns);
+
+        RecordField& field = mFields[mFieldsCount++];
+        field.mName = name;
+        field.mExpected = ExpectedArgType<T>::value;
+        field.mBind = &BindRecordField<Record, T>;
+        field.mResize = nullptr;
+        memcpy(field.mMember, &member, sizeof(member));
+        return *this;
+    }
+
+    template <typename Record>
+    template <typename T>
+    inline RecordSchema<Record>& RecordSchema<Record>::Column(const char * name, std::vector<T> Record::* column)
+    {
+        static_assert(sizeof(column) <= sizeof(RecordField::mMember), "Member pointer does not fit into RecordField");
+        assert(mFieldsCount < kMaxFields && (mColumns || mFieldsCount == 0));
+
+        mColumns = true;
+        RecordField& field = mFields[mFieldsCount++];
+        field.mName = name;
+        field.mExpected = ExpectedArgType<T>::value;
+        field.mBind = &BindRecordColumn<Record, T>;
+        field.mResize = &ResizeRecordColumn<Record, T>;
+        memcpy(field.mMember, &column, sizeof(column));
+        return *this;
+    }
+
+    template <typename Record>
+    inline bool RecordSchema<Record>::HasColumns() const
+    {
+        return mColumns;
+    }
+
+    template <typename Record>
+    inline void RecordSchema<Record>::ResizeColumns(Record& columns, size_t length) const
+    {
+        for (size_t f = 0; f < mFieldsCount; f++)
+            mFields[f].mResize(mFields[f], &columns, length);
+    }
+
+    template <typename Record>
+    template <typename Prepare, typename Target>
+    inline bool RecordSchema<Record>::BindElements(v8::Local<v8::Value> value, const Prepare& prepare, const Target& target, CheckFailure& failure) const
+    {
+        if (!value->IsArray())
+        {
+            failure = CheckFailure::Violation(CheckErrorCode::Bind, -1, "Records", ArgType::Array, value);
+            return false;
+        }
+
+        v8::Local<v8::Array> array = value.As<v8::Array>();
+        uint32_t length = array->Length();
+
+        if (!prepare(length))
+        {
+            failure = CheckFailure::Violation(CheckErrorCode::Bind, -1, "Records", ArgType::Array, value);
+            return false;
+        }
+
+        // Keys are looked up once per call rather than once per element
+        v8::Local<v8::String> keys[kMaxFields];
+        for (size_t f = 0; f < mFieldsCount; f++)
+            keys[f] = PropertyKeyCache::Get(mFields[f].mName);
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            Nan::HandleScope scope;
+
+            // An empty element or property means its getter threw
+            v8::Local<v8::Value> element;
+            if (!Nan::Get(array, i).ToLocal(&element))
+            {
+                failure = CheckFailure::Violation(CheckErrorCode::Exception, -1, "Records", ArgType::Object, ArgType::Unknown);
+                failure.mElementIndex = i;
+                return false;
+            }
+
+            if (!element->IsObject())
+            {
+                failure = CheckFailure::Violation(CheckErrorCode::Bind, -1, "Records", ArgType::Object, element);
+                failure.mElementIndex = i;
+                return false;
+            }
+
+            v8::Local<v8::Object> object = element.As<v8::Object>();
+            void * record = target(i);
+
+            for (size_t f = 0; f < mFieldsCount; f++)
+            {
+                const RecordField& field = mFields[f];
+
+                v8::Local<v8::Value> property;
+                bool read = Nan::Get(object, keys[f]).ToLocal(&property);
+                if (!read || !field.mBind(field, property, record, i))
+                {
+                    failure = read ? CheckFailure::Violation(CheckErrorCode::Bind, -1, "Records", field.mExpected, property)
+                                   : CheckFailure::Violation(CheckErrorCode::Exception, -1, "Records", field.mExpected, ArgType::Unknown);
+                    failure.mElementIndex = i;
+                    failure.mProperty = field.mName;
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <typename Record>
+    inline ArgRecords<Record> MethodArgBinding::Records(const RecordSchema<Record>& schema)
+    {
+        return ArgRecords<Record>(schema, *this, mArgIndex);
+    }
+
+    template <typename Record>
+    inline ArgRecords<Record>::ArgRecords(const RecordSchema<Record>& schema, MethodArgBinding& owner, int argIndex)
+        : mSchema(schema)
+        , mOwner(owner)
+        , mArgIndex(argIndex)
+    {
+    }
+
+    template <typename Record>
+    template <typename Prepare, typename Target>
+    inline CheckArguments& ArgRecords<Record>::AddClause(const Prepare& prepare, const Target& target)
+    {
+        return mOwner.mParent.AddAndClause([this, prepare, target](Nan::NAN_METHOD_ARGS_TYPE args) {
+            CheckFailure failure;
+            if (!mSchema.BindElements(args[mArgIndex], prepare, target, failure))
+            {
+                failure.mArgIndex = mArgIndex;
+                return mOwner.mParent.Fail(failure);
+            }
+
+            return true;
+        });
+    }
+
+    template <typename Record>
+    inline CheckArguments& ArgRecords<Record>::Bind(std::vector<Record>& records)
+    {
+        assert(!mSchema.HasColumns());
+
+        std::vector<Record> * out = &records;
+        return AddClause(
+            [out](size_t length) { out->resize(length); return true; },
+            [out](size_t index) -> void * { return &(*out)[index]; });
+    }
+
+    template <typename Record>
+    inline CheckArguments& ArgRecords<Record>::Bind(Span<Record> buffer, size_t& count)
+    {
+        assert(!mSchema.HasColumns());
+
+        size_t * outCount = &count;
+        return AddClause(
+            [buffer, outCount](size_t length) { *outCount = length; return length <= buffer.Length(); },
+            [buffer](size_t index) -> void * { return buffer.Data() + index; });
+    }
+
+    template <typename Record>
+    inline CheckArguments& ArgRecords<Record>::BindColumns(Record& columns, size_t& count)
+    {
+        assert(mSchema.HasColumns());
+
+        const RecordSchema<Record> * schema = &mSchema;
+        Record * out = &columns;
+        size_t * outCount = &count;
+        return AddClause(
+            [schema, out, outCount](size_t length) { *outCount = length; schema->ResizeColumns(*out, length); return true; },
+            [out](size_t) -> void * { return out; });
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <size_t Capacity>
+    inline StringBuffer<Capacity>::StringBuffer()
+        : mLength(0)
+    {
+        mData[0] = 0;
+    }
+
+    template <size_t Capacity>
+    inline const char * StringBuffer<Capacity>::Data() const
+    {
+        return mData;
+    }
+
+    template <size_t Capacity>
+    inline const char * StringBuffer<Capacity>::c_str() const
+    {
+        return mData;
+    }
+
+    template <size_t Capacity>
+    inline size_t StringBuffer<Capacity>::Length() const
+    {
+        return mLength;
+    }
+
+    template <size_t Capacity>
+    inline bool ArgBinder< StringBuffer<Capacity> >::Bind(v8::Local<v8::Value> value, StringBuffer<Capacity>& outValue)
+    {
+        v8::Local<v8::String> str;
+        if (!StringArgument(value, str))
+            return false;
+
+        ssize_t length = Utf8LengthWithin(str, Capacity);
+        if (length < 0)
+            return false;
+
+        Nan::DecodeWrite(outValue.mData, length, str, Nan::UTF8);
+        outValue.mData[length] = 0;
+        outValue.mLength = static_cast<size_t>(length);
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    inline bool MarshalBinder<T>::Bind(v8::Local<v8::Value> value, T& outValue)
+    {
+        try
+        {
+            outValue = Nan::Marshal<T>(value);
+            return true;
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    template <typename T>
+    inline bool ArgBinder< v8::Local<T> >::Bind(v8::Local<v8::Value> value, v8::Local<T>& outValue)
+    {
+        outValue = value.As<T>();
+        return true;
+    }
+
+    template <typename T>
+    inline bool ArgBinder< Span<T> >::Bind(v8::Local<v8::Value> value, Span<T>& outValue)
+    {
+        typedef typename std::remove_const<T>::type Element;
+
+        char *  data;
+        size_t  length;
+
+        if (TypedArrayTraits<Element>::IsInstance(value))
+        {
+            Nan::TypedArrayContents<Element> contents(value);
+            data = reinterpret_cast<char*>(*contents);
+            length = contents.length();
+        }
+#if NODE_MODULE_VERSION < IOJS_3_0_MODULE_VERSION
+        // Buffers are not Uint8Arrays yet
+        else if (TypedArrayTraits<Element>::kIsByte && node::Buffer::HasInstance(value))
+        {
+            data = node::Buffer::Data(value);
+            length = node::Buffer::Length(value);
+        }
+#endif
+        else
+        {
+            return false;
+        }
+
+        if (reinterpret_cast<uintptr_t>(data) % alignof(Element) != 0)
+            return false;
+
+        outValue = Span<T>(reinterpret_cast<T*>(data), length);
+        return true;
+    }
+
+    template <typename T>
+    inline Span<T>::Span()
+        : mData(nullptr)
+        , mLength(0)
+    {
+    }
+
+    template <typename T>
+    inline Span<T>::Span(T * data, size_t length)
+        : mData(data)
+        , mLength(length)
+    {
+    }
+
+    template <typename T>
+    inline T * Span<T>::Data() const
+    {
+        return mData;
+    }
+
+    template <typename T>
+    inline size_t Span<T>::Length() const
+    {
+        return mLength;
+    }
+
+    template <typename T>
+    inline size_t Span<T>::ByteLength() const
+    {
+        return mLength * sizeof(T);
+    }
+
+    template <typename T>
+    inline T& Span<T>::operator[](size_t index) const
+    {
+        return mData[index];
+    }
+
+    template <typename T>
+    inline T * Span<T>::begin() const
+    {
+        return mData;
+    }
+
+    template <typename T>
+    inline T * Span<T>::end() const
+    {
+        return mData + mLength;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    struct NumberConverter<T, true>
+    {
+        static bool Convert(double value, T& outValue)
+        {
+            // NaN fails the first comparison; the maximum of 64-bit types rounds up to a power of two
+            if (!(std::trunc(value) == value) ||
+                value < static_cast<double>(std::numeric_limits<T>::min()) ||
+                value > static_cast<double>(std::numeric_limits<T>::max()) ||
+                (sizeof(T) >= sizeof(double) && value == static_cast<double>(std::numeric_limits<T>::max())))
+                return false;
+
+            outValue = static_cast<T>(value);
+            return true;
+        }
+
+        static bool Convert(int32_t value, T& outValue)
+        {
+            // Only types narrower than int32 or unsigned can reject an int32
+            if ((std::is_unsigned<T>::value && value < 0) ||
+                (sizeof(T) < sizeof(int32_t) &&
+                 (value < static_cast<int32_t>(std::numeric_limits<T>::min()) ||
+                  value > static_cast<int32_t>(std::numeric_limits<T>::max()))))
+                return false;
+
+            outValue = static_cast<T>(value);
+            return true;
+        }
+    };
+
+    template <typename T>
+    struct NumberConverter<T, false>
+    {
+        static bool Convert(double value, T& outValue)
+        {
+            outValue = static_cast<T>(value);
+            return true;
+        }
+
+        static bool Convert(int32_t value, T& outValue)
+        {
+            outValue = static_cast<T>(value);
+            return true;
+        }
+    };
+
+    template <>
+    struct NumberConverter<bool, true>
+    {
+        static bool Convert(double value, bool& outValue)
+        {
+            return false;
+        }
+
+        static bool Convert(int32_t value, bool& outValue)
+        {
+            return false;
+        }
+    };
+
+    template <typename T>
+    inline bool NumberBinder<T>::Bind(v8::Local<v8::Value> value, T& outValue)
+    {
+        // Small integers are stored untagged by V8, so both the test and the read are cheap
+        if (value->IsInt32())
+            return NumberConverter<T>::Convert(value.As<v8::Int32>()->Value(), outValue);
+
+        return value->IsNumber() && NumberConverter<T>::Convert(value.As<v8::Number>()->Value(), outValue);
+    }
+
+    template <>
+    inline bool NumberBinder<bool>::Bind(v8::Local<v8::Value> value, bool& outValue)
+    {
+        if (!value->IsBoolean())
+            return false;
+
+        outValue = value->IsTrue();
+        return true;
+    }
+
+#if defined(V8_MAJOR_VERSION) && V8_MAJOR_VERSION >= 12
+    template <typename T>
+    struct ArrayIterationState
+    {
+        T *     mOut;
+        bool    mOk;
+    };
+
+    template <typename T>
+    inline v8::Array::CallbackResult BindIteratedElement(uint32_t index, v8::Local<v8::Value> element, void * data)
+    {
+        ArrayIterationState<T> * state = static_cast<ArrayIterationState<T>*>(data);
+        state->mOk = ArgBinder<T>::Bind(element, state->mOut[index]);
+        return state->mOk ? v8::Array::CallbackResult::kContinue : v8::Array::CallbackResult::kBreak;
+    }
+#endif
+
+    template <typename T, typename U>
+    inline bool ConvertTypedArray(v8::Local<v8::Value> value, T * out)
+    {
+        Nan::TypedArrayContents<U> contents(value);
+        const U * in = *contents;
+
+        for (size_t i = 0; i < contents.length(); i++)
+        {
+            if (!NumberConverter<T>::Convert(static_cast<double>(in[i]), out[i]))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    inline bool BindTypedArrayElements(v8::Local<v8::Value> value, T * out, size_t length, std::true_type)
+    {
+        if (TypedArrayTraits<T>::IsInstance(value))
+        {
+            Nan::TypedArrayContents<T> contents(value);
+            std::copy(*contents, *contents + length, out);
+            return true;
+        }
+
+#if NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION
+        if (value->IsFloat64Array())
+            return ConvertTypedArray<T, double>(value, out);
+        if (value->IsFloat32Array())
+            return ConvertTypedArray<T, float>(value, out);
+        if (value->IsInt32Array())
+            return ConvertTypedArray<T, int32_t>(value, out);
+        if (value->IsUint32Array())
+            return ConvertTypedArray<T, uint32_t>(value, out);
+        if (value->IsInt16Array())
+            return ConvertTypedArray<T, int16_t>(value, out);
+        if (value->IsUint16Array())
+            return ConvertTypedArray<T, uint16_t>(value, out);
+        if (value->IsInt8Array())
+            return ConvertTypedArray<T, int8_t>(value, out);
+        if (value->IsUint8Array() || value->IsUint8ClampedArray())
+            return ConvertTypedArray<T, uint8_t>(value, out);
+#endif
+        return false;
+    }
+
+    template <typename T>
+    inline bool BindTypedArrayElements(v8::Local<v8::Value> value, T * out, size_t length, std::false_type)
+    {
+        return false;
+    }
+
+    template <typename T>
+    inline bool BindPlainArrayElements(v8::Local<v8::Array> array, T * out, uint32_t length, std::false_type)
+    {
+        for (uint32_t i = 0; i < length; i++)
+        {
+            v8::Local<v8::Value> element;
+            if (!Nan::Get(array, i).ToLocal(&element) || !ArgBinder<T>::Bind(element, out[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    inline bool BindPlainArrayElements(v8::Local<v8::Array> array, T * out, uint32_t length, std::true_type)
+    {
+#if defined(V8_MAJOR_VERSION) && V8_MAJOR_VERSION >= 12
+        // Iterate() walks packed SMI and double elements without per-element lookups;
+        // reading numbers does not allocate, as its callback requires
+        ArrayIterationState<T> state = { out, true };
+        if (array->Iterate(Nan::GetCurrentContext(), &BindIteratedElement<T>, &state).IsNothing())
+            return false;
+
+        return state.mOk;
+#else
+        return BindPlainArrayElements<T>(array, out, length, std::false_type());
+#endif
+    }
+
+    template <typename T, typename Allocate>
+    inline bool BindArrayElements(v8::Local<v8::Value> value, const Allocate& allocate)
+    {
+        T * out = nullptr;
+
+#if NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION
+        if (value->IsTypedArray())
+        {
+            typedef std::integral_constant<bool, std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> IsNumeric;
+
+            size_t length = value.As<v8::TypedArray>()->Length();
+            return allocate(length, out) && BindTypedArrayElements<T>(value, out, length, IsNumeric());
+        }
+#endif
+
+        if (!value->IsArray())
+            return false;
+
+        v8::Local<v8::Array> array = value.As<v8::Array>();
+        uint32_t length = array->Length();
+
+        return allocate(length, out) && BindPlainArrayElements<T>(array, out, length, std::is_arithmetic<T>());
+    }
+
+    template <typename T>
+    inline bool ArgBinder< std::vector<T> >::Bind(v8::Local<v8::Value> value, std::vector<T>& outValue)
+    {
+        return BindArrayElements<T>(value, [&outValue](size_t length, T *& out) {
+            outValue.resize(length);
+            out = outValue.data();
+            return true;
+        });
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    inline Lazy<T>::Lazy()
+        : mValue()
+        , mArgIndex(-1)
+        , mState(Unbound)
+    {
+    }
+
+    template <typename T>
+    inline bool Lazy<T>::IsBound() const
+    {
+        return mState != Unbound;
+    }
+
+    template <typename T>
+    inline bool Lazy<T>::IsResolved() const
+    {
+        return mState == Converted || mState == Failed;
+    }
+
+    template <typename T>
+    inline bool Lazy<T>::Resolve(const CheckReport& report)
+    {
+        if (mState == Pending)
+            mState = ArgBinder<T>::Bind(mHandle, mValue) ? Converted : Failed;
+
+        if (mState == Converted)
+            return true;
+
+        return report.Fail(CheckFailure::Violation(CheckErrorCode::Bind, mArgIndex, "Lazy", ExpectedArgType<T>::value,
+                                                   mState == Unbound ? v8::Local<v8::Value>(Nan::Undefined()) : mHandle));
+    }
+
+    template <typename T>
+    inline T& Lazy<T>::Get()
+    {
+        CheckFailure failure;
+        if (!Resolve(&failure))
+            throw CheckException(failure.Message());
+
+        return mValue;
+    }
+
+    template <typename T>
+    inline v8::Local<v8::Value> Lazy<T>::Handle() const
+    {
+        return mHandle;
+    }
+
+    template <typename T>
+    inline bool ArgBinder< Lazy<T> >::Bind(v8::Local<v8::Value> value, Lazy<T>& outValue)
+    {
+        if (!ArgTypeMatches(ExpectedArgType<T>::value, value))
+            return false;
+
+        outValue.mHandle = value;
+        outValue.mState = Lazy<T>::Pending;
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    /**
+     * @brief Address of BindingType<T>::id identifies T when checking Check() targets
+     */
+    template <typename T>
+    struct BindingType
+    {
+        static const char id;
+    };
+
+    template <typename T>
+    const char BindingType<T>::id = 0;
+
+    template <typename T>
+    inline T& IsolateContext::Data()
+    {
+        const void * type = &BindingType<T>::id;
+
+        for (auto& data : mData)
+        {
+            if (data.first == type)
+                return *static_cast<T *>(data.second.get());
+        }
+
+        std::shared_ptr<T> data = std::make_shared<T>();
+        mData.push_back(std::make_pair(type, std::shared_ptr<void>(data)));
+        return *data;
+    }
+
+    template <typename T>
+    inline bool SchemaBindValue(const SchemaClause& clause, v8::Local<v8::Value> value, void * target)
+    {
+        return ArgBinder<T>::Bind(value, *static_cast<T*>(target));
+    }
+
+    template <typename T>
+    inline bool SchemaBindStringEnum(const SchemaClause& clause, v8::Local<v8::Value> value, void * target)
+    {
+        const StringEnumTable<T> * table = static_cast<const StringEnumTable<T>*>(clause.mData.get());
+        return table->Match(value, *static_cast<T*>(target));
+    }
+
+    template <typename T>
+    inline SchemaBuilder& SchemaBuilder::AddBinding(const SchemaClause& clause)
+    {
+        SchemaClause binding = clause;
+        binding.mSlot = static_cast<int>(mBindingTypes.size());
+        mBindingTypes.push_back(&BindingType<T>::id);
+        return AddClause(binding);
+    }
+
+    template <typename... Targets>
+    inline bool CheckSchema::Check(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Targets&... targets) const
+    {
+        void * const        pointers[] = { nullptr, static_cast<void*>(&targets)... };
+        const void * const  types[]    = { nullptr, &BindingType<Targets>::id... };
+
+        return Evaluate(args, report, pointers + 1, types + 1, sizeof...(Targets));
+    }
+
+    template <typename T>
+    inline SchemaBuilder& SchemaArgBinding::Bind()
+    {
+        SchemaClause clause = { "Bind", ExpectedArgType<T>::value, mArgIndex, 0, 0, -1, &SchemaBindValue<T>, nullptr, nullptr };
+        return mParent.AddBinding<T>(clause);
+    }
+
+    template <typename T>
+    inline bool SchemaBindProperty(const SchemaClause& clause, v8::Local<v8::Value> value, void * target)
+    {
+        v8::Local<v8::Value> property;
+        return BindProperty(value, clause.mProperty, *static_cast<T*>(target), property);
+    }
+
+    template <typename T>
+    inline SchemaBuilder& SchemaProperty::Bind()
+    {
+        SchemaClause clause = { "Property", ExpectedArgType<T>::value, mArgIndex, 0, 0, -1, &SchemaBindProperty<T>, nullptr, mName };
+        return mParent.AddBinding<T>(clause);
+    }
+
+    template <typename T>
+    inline SchemaStringEnum<T> SchemaArgBinding::StringEnum(std::initializer_list< std::pair<const char*, T> > possibleValues)
+    {
+        return SchemaStringEnum<T>(std::make_shared< const StringEnumTable<T> >(possibleValues), IsString().mParent, mArgIndex);
+    }
+
+    template <typename T>
+    inline SchemaStringEnum<T> SchemaArgBinding::StringEnum(const StringEnumTable<T>& table)
+    {
+        // Tables passed by reference are statics owned by the caller
+        return SchemaStringEnum<T>(std::shared_ptr< const StringEnumTable<T> >(&table, [](const StringEnumTable<T>*) {}), IsString().mParent, mArgIndex);
+    }
+
+    template <typename T>
+    inline SchemaStringEnum<T>::SchemaStringEnum(
+        std::shared_ptr< const StringEnumTable<T> > table,
+        SchemaBuilder& parent, int argIndex)
+        : mTable(table)
+        , mParent(parent)
+        , mArgIndex(argIndex)
+    {
+    }
+
+    template <typename T>
+    inline SchemaBuilder& SchemaStringEnum<T>::Bind()
+    {
+        SchemaClause clause = { "StringEnum", ArgType::String, mArgIndex, 0, 0, -1, &SchemaBindStringEnum<T>, mTable, nullptr };
+        return mParent.AddBinding<T>(clause);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename T>
+    inline StringEnumTable<T>::StringEnumTable(std::initializer_list< std::pair<const char*, T> > possibleValues)
+        : mSeed(0)
+        , mMaxLength(0)
+    {
+        for (const std::pair<const char*, T>& value : possibleValues)
+        {
+            // Keep the first value of duplicated keys
+            size_t length = std::strlen(value.first);
+            bool duplicate = false;
+            for (const Entry& entry : mEntries)
+            {
+                duplicate = duplicate || (entry.mLength == length && mKeys.compare(entry.mOffset, length, value.first) == 0);
+            }
+
+            if (!duplicate)
+            {
+                Entry entry = { mKeys.size(), length, value.second };
+                mEntries.push_back(entry);
+                mKeys.append(value.first, length);
+                mMaxLength = std::max(mMaxLength, length);
+            }
+        }
+
+        // Search for a seed that maps every key to its own slot
+        size_t size = 4;
+        while (size < mEntries.size() * 2)
+            size *= 2;
+
+        for (;; size *= 2)
+        {
+            for (uint32_t seed = 0; seed < 64; seed++)
+            {
+                if (TryBuildSlots(seed, size))
+                    return;
+            }
+        }
+    }
+
+    template <typename T>
+    inline uint32_t StringEnumTable<T>::Hash(const char * key, size_t length, uint32_t seed)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u ^ (seed * 16777619u);
+        for (size_t i = 0; i < length; i++)
+        {
+            hash ^= static_cast<unsigned char>(key[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    template <typename T>
+    inline bool StringEnumTable<T>::TryBuildSlots(uint32_t seed, size_t size)
+    {
+        mSlots.assign(size, -1);
+        mSeed = seed;
+
+        for (size_t i = 0; i < mEntries.size(); i++)
+        {
+            int& slot = mSlots[Hash(mKeys.data() + mEntries[i].mOffset, mEntries[i].mLength, seed) & (size - 1)];
+            if (slot >= 0)
+                return false;
+
+            slot = static_cast<int>(i);
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    inline bool StringEnumTable<T>::Match(v8::Local<v8::Value> value, T& outValue) const
+    {
+        return MatchStringKey(value, mMaxLength, [this, &outValue](const char * key, size_t length) {
+            return Match(key, length, outValue);
+        });
+    }
+
+    template <typename T>
+    inline bool StringEnumTable<T>::Match(const char * key, size_t length, T& outValue) const
+    {
+        if (mSlots.empty() || length > mMaxLength)
+            return false;
+
+        int slot = mSlots[Hash(key, length, mSeed) & (mSlots.size() - 1)];
+        if (slot < 0)
+            return false;
+
+        const Entry& entry = mEntries[slot];
+        if (entry.mLength != length || mKeys.compare(entry.mOffset, length, key, length) != 0)
+            return false;
+
+        outValue = entry.mValue;
+        return true;
+    }
+
+    template <typename EnumType>
+    inline bool SignatureArg< Arg::Enum<EnumType> >::Bind(v8::Local<v8::Value> value, EnumType& outValue)
+    {
+        return (value->IsString() || value->IsStringObject()) && StringEnumValues<EnumType>().Match(value, outValue);
+    }
+
+    template <typename... Args>
+    inline bool Signature<Args...>::Check(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, typename SignatureArg<Args>::Type&... values)
+    {
+        return Evaluate(args, report, std::tie(values...), typename MakeIndexSequence<sizeof...(Args)>::Type());
+    }
+
+    template <typename... Args>
+    inline bool Signature<Args...>::Check(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Values& values)
+    {
+        return Evaluate<Values&>(args, report, values, typename MakeIndexSequence<sizeof...(Args)>::Type());
+    }
+
+    template <typename... Args>
+    template <typename Tuple, size_t... Indices>
+    inline bool Signature<Args...>::Evaluate(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Tuple values, IndexSequence<Indices...>)
+    {
+        if (args.Length() != Arity)
+            return Fail(args, report, -1);
+
+        int failedIndex = -1;
+        bool ok = true;
+        int unwind[] = { 0, (ok = ok && (SignatureArg<Args>::Bind(args[Indices], std::get<Indices>(values)) || (failedIndex = Indices, false)), 0)... };
+        (void)unwind;
+
+        if (!ok)
+            return Fail(args, report, failedIndex);
+
+        return true;
+    }
+
+    template <typename... Args>
+    inline bool Signature<Args...>::Accepts(const ArgumentFingerprint& fingerprint)
+    {
+        return fingerprint.Length() == Arity && Accepts(fingerprint, typename MakeIndexSequence<sizeof...(Args)>::Type());
+    }
+
+    template <typename... Args>
+    template <size_t... Indices>
+    inline bool Signature<Args...>::Accepts(const ArgumentFingerprint& fingerprint, IndexSequence<Indices...>)
+    {
+        bool ok = true;
+        int unwind[] = { 0, (ok = ok && SignatureArg<Args>::Accepts(fingerprint.Traits(static_cast<int>(Indices))), 0)... };
+        (void)unwind;
+        return ok;
+    }
+
+    template <typename... Args>
+    inline bool Signature<Args...>::Fail(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, int argIndex)
+    {
+        if (argIndex < 0)
+            return report.Fail(CheckFailure::ArgumentsCount(args.Length(), Arity, Arity));
+
+        const char *         names[]    = { "", SignatureArg<Args>::Name()... };
+        const ArgType        expected[] = { ArgType::Unknown, SignatureArg<Args>::Expected()... };
+        const CheckErrorCode codes[]    = { CheckErrorCode::None, SignatureArg<Args>::Code()... };
+
+        return report.Fail(CheckFailure::Violation(codes[argIndex + 1], argIndex, names[argIndex + 1], expected[argIndex + 1], args[argIndex]));
+    }
+
+    template <typename... Args>
+    template <typename Worker>
+    inline bool Signature<Args...>::QueueAs(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report)
+    {
+        Values values;
+        if (!Check(args, report, values))
+            return false;
+
+        Worker * worker = new Worker(Payload(values));
+        Pin(worker, args, typename MakeIndexSequence<sizeof...(Args)>::Type());
+        Nan::AsyncQueueWorker(worker);
+        return true;
+    }
+
+    template <typename... Args>
+    template <typename Worker, size_t... Indices>
+    inline void Signature<Args...>::Pin(Worker * worker, Nan::NAN_METHOD_ARGS_TYPE args, IndexSequence<Indices...>)
+    {
+        int unwind[] = { 0, (PayloadArg<Args>::kPinned ? worker->SaveToPersistent(static_cast<uint32_t>(Indices), args[Indices]) : (void)0, 0)... };
+        (void)unwind;
+    }
+
+    template <typename... Args>
+    inline WorkerPayload<Args...>::WorkerPayload()
+    {
+    }
+
+    template <typename... Args>
+    inline WorkerPayload<Args...>::WorkerPayload(const typename Signature<Args...>::Values& bound)
+    {
+        Capture(bound, typename MakeIndexSequence<sizeof...(Args)>::Type());
+    }
+
+    template <typename... Args>
+    inline WorkerPayload<Args...>::WorkerPayload(WorkerPayload&& other)
+        : mValues(std::move(other.mValues))
+        , mStrings(std::move(other.mStrings))
+    {
+    }
+
+    template <typename... Args>
+    inline WorkerPayload<Args...>& WorkerPayload<Args...>::operator=(WorkerPayload&& other)
+    {
+        mValues = std::move(other.mValues);
+        mStrings = std::move(other.mStrings);
+        return *this;
+    }
+
+    template <typename... Args>
+    template <size_t... Indices>
+    inline void WorkerPayload<Args...>::Capture(const typename Signature<Args...>::Values& bound, IndexSequence<Indices...>)
+    {
+        size_t sizes[] = { 0, PayloadArg<Args>::StorageSize(std::get<Indices>(bound))... };
+
+        size_t total = 0;
+        for (size_t size : sizes)
+            total += size;
+
+        if (total > 0)
+            mStrings.reset(new char[total]);
+
+        char * storage = mStrings.get();
+        int unwind[] = { 0, (PayloadArg<Args>::Capture(std::get<Indices>(bound), sizes[Indices + 1], storage, std::get<Indices>(mValues)), 0)... };
+        (void)unwind;
+    }
+
+    template <typename... Args>
+    template <size_t Index>
+    inline typename std::tuple_element<Index, typename WorkerPayload<Args...>::Values>::type& WorkerPayload<Args...>::Get()
+    {
+        return std::get<Index>(mValues);
+    }
+
+    template <typename... Args>
+    template <size_t Index>
+    inline const typename std::tuple_element<Index, typename WorkerPayload<Args...>::Values>::type& WorkerPayload<Args...>::Get() const
+    {
+        return std::get<Index>(mValues);
+    }
+
+    template <typename... Args>
+    inline Nan::Callback * WorkerPayload<Args...>::ReleaseCompletion()
+    {
+        static_assert(kCompletion >= 0, "A signature queued as a worker needs an Arg::Function completion callback");
+
+        return std::get<kCompletion < 0 ? 0 : kCompletion>(mValues).release();
+    }
+
+    template <typename Base>
+    inline PooledCallbackWorker<Base>::PooledCallbackWorker(PooledCallback&& callback)
+        : Base(nullptr)
+        , mCallback(std::move(callback))
+    {
+    }
+
+    template <typename Base>
+    inline void PooledCallbackWorker<Base>::HandleOKCallback()
+    {
+        Nan::HandleScope scope;
+        mCallback.Call(0, nullptr, this->async_resource);
+    }
+
+    template <typename Base>
+    inline void PooledCallbackWorker<Base>::HandleErrorCallback()
+    {
+        Nan::HandleScope scope;
+
+        v8::Local<v8::Value> argv[] = {
+            v8::Exception::Error(Nan::New<v8::String>(this->ErrorMessage()).ToLocalChecked())
+        };
+        mCallback.Call(1, argv, this->async_resource);
+    }
+
+    template <typename SignatureType, typename Base>
+    inline PayloadWorker<SignatureType, Base>::PayloadWorker(Payload&& payload)
+        : Base(payload.ReleaseCompletion())
+        , mPayload(std::move(payload))
+    {
+    }
+
+    template <typename... Args>
+    inline const ArgType * Signature<Args...>::ExpectedTypes()
+    {
+        static const ArgType types[] = { ArgType::Unknown, SignatureArg<Args>::Expected()... };
+        return types + 1;
+    }
+
+    template <typename... Signatures>
+    inline int Overloads<Signatures...>::Select(Nan::NAN_METHOD_ARGS_TYPE args)
+    {
+        typedef bool (*AcceptsFunction)(const ArgumentFingerprint& fingerprint);
+        static const AcceptsFunction accepts[] = { &Signatures::Accepts... };
+
+        if (args.Length() > MaxArity)
+            return -1;
+
+        // Each overload judges the traits the way its binders will, so the selected one binds
+        ArgumentFingerprint fingerprint(args);
+        for (int overload = 0; overload < Count; overload++)
+        {
+            if (accepts[overload](fingerprint))
+                return overload;
+        }
+
+        return -1;
+    }
+
+    template <typename... Signatures>
+    template <typename... Handlers>
+    inline bool Overloads<Signatures...>::Dispatch(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handlers&&... handlers)
+    {
+        static_assert(sizeof...(Handlers) == sizeof...(Signatures), "Dispatch needs one handler per overload");
+
+        int selected = Select(args);
+        if (selected < 0)
+            return report.Fail(CheckFailure::Overload(args.Length(), Description()));
+
+        std::tuple<Handlers&...> all(handlers...);
+        return Invoke(selected, args, report, all, std::integral_constant<size_t, 0>());
+    }
+
+    template <typename... Signatures>
+    inline const char * Overloads<Signatures...>::Description()
+    {
+        static const std::string description = []() {
+            const int          arities[]  = { Signatures::Arity... };
+            const ArgType *    expected[] = { Signatures::ExpectedTypes()... };
+
+            std::string result;
+            for (int overload = 0; overload < Count; overload++)
+            {
+                result += overload ? " or (" : "(";
+                for (int i = 0; i < arities[overload]; i++)
+                {
+                    result += i ? ", " : "";
+                    result += expected[overload][i] == ArgType::Unknown ? "any" : ArgTypeName(expected[overload][i]);
+                }
+                result += ")";
+            }
+            return result;
+        }();
+
+        return description.c_str();
+    }
+
+    template <typename... Signatures>
+    template <typename Handlers>
+    inline bool Overloads<Signatures...>::Invoke(int, Nan::NAN_METHOD_ARGS_TYPE, CheckReport, Handlers&, std::integral_constant<size_t, sizeof...(Signatures)>)
+    {
+        return false;
+    }
+
+    template <typename... Signatures>
+    template <typename Handlers, size_t Index>
+    inline bool Overloads<Signatures...>::Invoke(int selected, Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handlers& handlers, std::integral_constant<size_t, Index>)
+    {
+        typedef typename std::tuple_element<Index, std::tuple<Signatures...> >::type SignatureType;
+
+        if (selected != static_cast<int>(Index))
+            return Invoke(selected, args, report, handlers, std::integral_constant<size_t, Index + 1>());
+
+        return Call<SignatureType>(args, report, std::get<Index>(handlers), typename MakeIndexSequence<SignatureType::Arity>::Type());
+    }
+
+    template <typename T, size_t Capacity>
+    inline ProgressRing<T, Capacity>::ProgressRing()
+        : mHead(0)
+        , mTail(0)
+    {
+    }
+
+    template <typename T, size_t Capacity>
+    inline bool ProgressRing<T, Capacity>::Push(const T& value)
+    {
+        size_t head = mHead.load(std::memory_order_relaxed);
+        if (head - mTail.load(std::memory_order_acquire) == Capacity)
+            return false;
+
+        mValues[head & (Capacity - 1)] = value;
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T, size_t Capacity>
+    inline size_t ProgressRing<T, Capacity>::Pop(T * values, size_t maxCount)
+    {
+        size_t tail = mTail.load(std::memory_order_relaxed);
+        size_t count = std::min(mHead.load(std::memory_order_acquire) - tail, maxCount);
+
+        for (size_t i = 0; i < count; i++)
+            values[i] = mValues[(tail + i) & (Capacity - 1)];
+
+        mTail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    template <typename T, size_t Capacity>
+    inline AsyncBatchProgressWorker<T, Capacity>::ExecutionProgress::ExecutionProgress(AsyncBatchProgressWorker * worker)
+        : mWorker(worker)
+    {
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::ExecutionProgress::Send(const T& value) const
+    {
+        mWorker->Send(value);
+    }
+
+    template <typename T, size_t Capacity>
+    inline AsyncBatchProgressWorker<T, Capacity>::AsyncBatchProgressWorker(Nan::Callback * callback, ProgressPolicy policy)
+        : Nan::AsyncWorker(callback)
+        , mPolicy(policy)
+        , mAsync(new uv_async_t)
+        , mWakePending(false)
+        , mDropped(0)
+        , mBatch(new T[Capacity])
+        , mOverflow()
+        , mHasOverflow(false)
+    {
+        uv_async_init(Nan::GetCurrentEventLoop(), mAsync, AsyncProgress);
+        mAsync->data = this;
+    }
+
+    template <typename T, size_t Capacity>
+    inline AsyncBatchProgressWorker<T, Capacity>::~AsyncBatchProgressWorker()
+    {
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::Execute()
+    {
+        ExecutionProgress progress(this);
+        Execute(progress);
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::Send(const T& value)
+    {
+        if (mHasOverflow)
+        {
+            if (mRing.Push(mOverflow))
+                mHasOverflow = false;
+            else
+                mDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (mHasOverflow || !mRing.Push(value))
+        {
+            // Keeps the newest update; it is retried on the next Send() or delivered on completion
+            mOverflow = value;
+            mHasOverflow = true;
+        }
+
+        if (mWakePending.load(std::memory_order_relaxed))
+            return;
+
+        if (mPolicy.mMode == ProgressCoalescing::Throttle)
+        {
+            Clock::time_point now = Clock::now();
+            if (now - mLastWake < std::chrono::milliseconds(mPolicy.mIntervalMs))
+                return;
+            mLastWake = now;
+        }
+
+        if (!mWakePending.exchange(true, std::memory_order_acq_rel))
+            uv_async_send(mAsync);
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::Deliver()
+    {
+        // Cleared before draining, so that a later Send() wakes the loop again
+        mWakePending.store(false, std::memory_order_release);
+
+        size_t count = mRing.Pop(mBatch.get(), Capacity);
+        if (count == 0)
+            return;
+
+        Nan::HandleScope scope;
+
+        if (mPolicy.mMode == ProgressCoalescing::Latest)
+            HandleProgressCallback(mBatch.get() + count - 1, 1);
+        else
+            HandleProgressCallback(mBatch.get(), count);
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::WorkComplete()
+    {
+        // The producer has finished, so its overflow slot can be read here
+        if (mHasOverflow && mPolicy.mMode == ProgressCoalescing::Latest)
+            mRing.Pop(mBatch.get(), Capacity);  // everything in the ring is older than the overflow
+        else
+            Deliver();
+
+        if (mHasOverflow)
+        {
+            mHasOverflow = false;
+            Nan::HandleScope scope;
+            HandleProgressCallback(&mOverflow, 1);
+        }
+
+        Nan::AsyncWorker::WorkComplete();
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::Destroy()
+    {
+        uv_close(reinterpret_cast<uv_handle_t*>(mAsync), AsyncClose);
+    }
+
+    template <typename T, size_t Capacity>
+    inline uint64_t AsyncBatchProgressWorker<T, Capacity>::Dropped() const
+    {
+        return mDropped.load(std::memory_order_relaxed);
+    }
+
+    template <typename T, size_t Capacity>
+    inline NAUV_WORK_CB((AsyncBatchProgressWorker<T, Capacity>::AsyncProgress))
+    {
+        static_cast<AsyncBatchProgressWorker*>(async->data)->Deliver();
+    }
+
+    template <typename T, size_t Capacity>
+    inline void AsyncBatchProgressWorker<T, Capacity>::AsyncClose(uv_handle_t * handle)
+    {
+        AsyncBatchProgressWorker * worker = static_cast<AsyncBatchProgressWorker*>(handle->data);
+        delete reinterpret_cast<uv_async_t*>(handle);
+        delete worker;
+    }
+
+    template <typename... Signatures>
+    template <typename SignatureType, typename Handler, size_t... Indices>
+    inline bool Overloads<Signatures...>::Call(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report, Handler& handler, IndexSequence<Indices...>)
+    {
+        typename SignatureType::Values values;
+        if (!SignatureType::Check(args, report, values))
+            return false;
+
+        handler(std::get<Indices>(values)...);
+        return true;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    template <typename Derived, typename R, typename... Args>
+    inline void FastMethodBase<Derived, R, Args...>::Method(Nan::NAN_METHOD_ARGS_TYPE info)
+    {
+        Invoke(info, typename MakeIndexSequence<sizeof...(Args)>::Type());
+    }
+
+    template <typename Derived, typename R, typename... Args>
+    template <size_t... Indices>
+    inline void FastMethodBase<Derived, R, Args...>::Invoke(Nan::NAN_METHOD_ARGS_TYPE info, IndexSequence<Indices...>)
+    {
+        typename SignatureType::Values values;
+        CheckFailure failure;
+
+        if (!SignatureType::Check(info, &failure, values))
+            return failure.ThrowTypeError();
+
+        Return(info, values, IndexSequence<Indices...>(), std::is_void<R>());
+    }
+
+    template <typename Derived, typename R, typename... Args>
+    template <size_t... Indices>
+    inline void FastMethodBase<Derived, R, Args...>::Return(Nan::NAN_METHOD_ARGS_TYPE info, typename SignatureType::Values& values,
+                                                            IndexSequence<Indices...>, std::false_type)
+    {
+        info.GetReturnValue().Set(Derived::Call(info.This(), std::get<Indices>(values)...));
+    }
+
+    template <typename Derived, typename R, typename... Args>
+    template <size_t... Indices>
+    inline void FastMethodBase<Derived, R, Args...>::Return(Nan::NAN_METHOD_ARGS_TYPE info, typename SignatureType::Values& values,
+                                                            IndexSequence<Indices...>, std::true_type)
+    {
+        Derived::Call(info.This(), std::get<Indices>(values)...);
+    }
+
+    template <typename Derived, typename R, typename... Args>
+    inline v8::Local<v8::FunctionTemplate> FastMethodBase<Derived, R, Args...>::Template()
+    {
+        return Nan::New<v8::FunctionTemplate>(Method);
+    }
+
+}
+
+namespace Nan
+{
+
+    inline uint16_t ClassifyTraits(v8::Local<v8::Value> value)
+    {
+        // Most frequent primitives first; object subtypes are only queried for objects
+        if (value->IsNumber())
+            return ArgTrait::Number;
+        if (value->IsString())
+            return ArgTrait::String;
+        if (value->IsUndefined())
+            return ArgTrait::Undefined;
+        if (value->IsNull())
+            return ArgTrait::Null;
+        if (value->IsBoolean())
+            return ArgTrait::Boolean;
+        if (!value->IsObject())
+            return 0;
+
+        if (value->IsFunction())
+            return ArgTrait::Object | ArgTrait::Function;
+        if (value->IsArray())
+            return ArgTrait::Object | ArgTrait::Array;
+
+#if NODE_MODULE_VERSION >= IOJS_3_0_MODULE_VERSION
+        // Buffers are Uint8Arrays since io.js 3
+        if (value->IsArrayBufferView())
+        {
+            uint16_t traits = ArgTrait::Object;
+            if (value->IsTypedArray())
+                traits |= ArgTrait::TypedArray;
+            if (node::Buffer::HasInstance(value))
+                traits |= ArgTrait::Buffer;
+            return traits;
+        }
+#else
+        if (node::Buffer::HasInstance(value))
+            return ArgTrait::Object | ArgTrait::Buffer;
+#if NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION
+        if (value->IsTypedArray())
+            return ArgTrait::Object | ArgTrait::TypedArray;
+#endif
+#endif
+
+        if (value->IsStringObject())
+            return ArgTrait::Object | ArgTrait::StringObject;
+        if (value->IsNumberObject())
+            return ArgTrait::Object | ArgTrait::NumberObject;
+        if (value->IsBooleanObject())
+            return ArgTrait::Object | ArgTrait::BooleanObject;
+
+        return ArgTrait::Object;
+    }
+
+    inline ArgType ArgTypeOf(uint16_t traits)
+    {
+        if (traits & ArgTrait::Undefined)
+            return ArgType::Undefined;
+        if (traits & ArgTrait::Null)
+            return ArgType::Null;
+        if (traits & (ArgTrait::Boolean | ArgTrait::BooleanObject))
+            return ArgType::Boolean;
+        if (traits & (ArgTrait::Number | ArgTrait::NumberObject))
+            return ArgType::Number;
+        if (traits & (ArgTrait::String | ArgTrait::StringObject))
+            return ArgType::String;
+        if (traits & ArgTrait::Function)
+            return ArgType::Function;
+        if (traits & ArgTrait::Buffer)
+            return ArgType::Buffer;
+        if (traits & ArgTrait::TypedArray)
+            return ArgType::TypedArray;
+        if (traits & ArgTrait::Array)
+            return ArgType::Array;
+        if (traits & ArgTrait::Object)
+            return ArgType::Object;
+
+        return ArgType::Unknown;
+    }
+
+    inline ArgType ClassifyArgument(v8::Local<v8::Value> value)
+    {
+        return ArgTypeOf(ClassifyTraits(value));
+    }
+
+    inline ArgumentFingerprint::ArgumentFingerprint()
+        : mInline()
+        , mLength(0)
+    {
+    }
+
+    inline ArgumentFingerprint::ArgumentFingerprint(Nan::NAN_METHOD_ARGS_TYPE args)
+        : mInline()
+        , mLength(0)
+    {
+        Classify(args);
+    }
+
+    inline void ArgumentFingerprint::Classify(Nan::NAN_METHOD_ARGS_TYPE args)
+    {
+        mLength = args.Length();
+
+        uint16_t * traits = mInline;
+        if (mLength > kInline)
+        {
+            mOverflow.resize(mLength);
+            traits = mOverflow.data();
+        }
+
+        for (int i = 0; i < mLength; i++)
+            traits[i] = ClassifyTraits(args[i]);
+    }
+
+    inline int ArgumentFingerprint::Length() const
+    {
+        return mLength;
+    }
+
+    inline uint16_t ArgumentFingerprint::Traits(int index) const
+    {
+        if (index < 0 || index >= mLength)
+            return ArgTrait::Undefined;
+
+        return mLength > kInline ? mOverflow[index] : mInline[index];
+    }
+
+    inline ArgType ArgumentFingerprint::Type(int index) const
+    {
+        return ArgTypeOf(Traits(index));
+    }
+
+    inline bool ArgumentFingerprint::Is(int index, uint16_t traits) const
+    {
+        return (Traits(index) & traits) != 0;
+    }
+
+    inline const char * ArgTypeName(ArgType type)
+    {
+        switch (type)
+        {
+        case ArgType::Undefined:    return "undefined";
+        case ArgType::Null:         return "null";
+        case ArgType::Boolean:      return "boolean";
+        case ArgType::Number:       return "number";
+        case ArgType::String:       return "string";
+        case ArgType::Function:     return "function";
+        case ArgType::Buffer:       return "buffer";
+        case ArgType::TypedArray:   return "typedarray";
+        case ArgType::Array:        return "array";
+        case ArgType::Object:       return "object";
+        default:                    return "unknown";
+        }
+    }
+
+    inline CheckFailure::CheckFailure()
+        : mCode(CheckErrorCode::None)
+        , mArgIndex(-1)
+        , mElementIndex(-1)
+        , mProperty(nullptr)
+        , mCheck(nullptr)
+        , mExpected(ArgType::Unknown)
+        , mActual(ArgType::Unknown)
+        , mActualCount(0)
+    {
+        mExpectedCount[0] = mExpectedCount[1] = 0;
+    }
+
+    inline CheckFailure CheckFailure::ArgumentsCount(int actual, int expected1, int expected2)
+    {
+        CheckFailure failure;
+        failure.mCode = CheckErrorCode::ArgumentsCount;
+        failure.mCheck = "ArgumentsCount";
+        failure.mActualCount = actual;
+        failure.mExpectedCount[0] = expected1;
+        failure.mExpectedCount[1] = expected2;
+        return failure;
+    }
+
+    inline CheckFailure CheckFailure::Violation(CheckErrorCode code, int argIndex, const char * check,
+                                                ArgType expected, v8::Local<v8::Value> actual)
+    {
+        CheckFailure failure;
+        failure.mCode = code;
+        failure.mArgIndex = argIndex;
+        failure.mCheck = check;
+        failure.mExpected = expected;
+        failure.mActual = ClassifyArgument(actual);
+        return failure;
+    }
+
+    inline CheckFailure CheckFailure::Violation(CheckErrorCode code, int argIndex, const char * check,
+                                                ArgType expected, ArgType actual)
+    {
+        CheckFailure failure;
+        failure.mCode = code;
+        failure.mArgIndex = argIndex;
+        failure.mCheck = check;
+        failure.mExpected = expected;
+        failure.mActual = actual;
+        return failure;
+    }
+
+    inline CheckFailure CheckFailure::Overload(int actualCount, const char * overloads)
+    {
+        CheckFailure failure;
+        failure.mCode = CheckErrorCode::Overload;
+        failure.mCheck = overloads;
+        failure.mActualCount = actualCount;
+        return failure;
+    }
+
+    inline std::string CheckFailure::Message() const
+    {
+        switch (mCode)
+        {
+        case CheckErrorCode::None:
+            return std::string();
+
+        case CheckErrorCode::ArgumentsCount:
+            return "Invalid number of arguments passed to a function";
+
+        case CheckErrorCode::Check:
+        case CheckErrorCode::Bind:
+            return Subject() + " violates " + mCheck + " check";
+
+        case CheckErrorCode::Exception:
+            return Subject() + " threw an exception";
+
+        case CheckErrorCode::Overload:
+            return std::string("Arguments do not match any overload: expected ") + mCheck;
+
+        default:
+            return "Unknown error";
+        }
+    }
+
+    inline std::string CheckFailure::Subject() const
+    {
+        if (mElementIndex >= 0 && mProperty)
+            return std::string("Property '") + mProperty + "' of element " + std::to_string(mElementIndex) + " of argument " + std::to_string(mArgIndex);
+
+        if (mElementIndex >= 0)
+            return std::string("Element ") + std::to_string(mElementIndex) + " of argument " + std::to_string(mArgIndex);
+
+        if (mProperty)
+            return std::string("Property '") + mProperty + "' of argument " + std::to_string(mArgIndex);
+
+        return std::string("Argument ") + std::to_string(mArgIndex);
+    }
+
+    inline void CheckFailure::ThrowTypeError() const
+    {
+        if (mCode == CheckErrorCode::Exception)
+            return;
+
+        Nan::ThrowTypeError(Message().c_str());
+    }
+
+    inline CheckReport::CheckReport(std::string * error)
+        : mError(error)
+        , mFailure(nullptr)
+    {
+    }
+
+    inline CheckReport::CheckReport(CheckFailure * failure)
+        : mError(nullptr)
+        , mFailure(failure)
+    {
+    }
+
+    inline CheckReport::CheckReport(std::nullptr_t)
+        : mError(nullptr)
+        , mFailure(nullptr)
+    {
+    }
+
+    inline bool CheckReport::Fail(const CheckFailure& failure) const
+    {
+        if (mError)
+        {
+            *mError = failure.Message();
+        }
+
+        if (mFailure)
+        {
+            *mFailure = failure;
+        }
+
+        return false;
+    }
+
+    inline CheckException::CheckException(const std::string& msg)
+        : std::runtime_error(msg)
+        , mMessage(msg)
+    {
+        mFailure.mCode = CheckErrorCode::Unknown;
+    }
+
+    inline CheckException::CheckException(int actual, int expected)
+        : std::runtime_error("Invalid number of arguments passed to a function")
+        , mMessage("Invalid number of arguments passed to a function")
+        , mFailure(CheckFailure::ArgumentsCount(actual, expected, expected))
+    {
+    }
+
+    inline CheckException::CheckException(int actual, const std::initializer_list<int>& expected)
+        : std::runtime_error("Invalid number of arguments passed to a function")
+        , mMessage("Invalid number of arguments passed to a function")
+        , mFailure(CheckFailure::ArgumentsCount(actual,
+                                                expected.size() > 0 ? *expected.begin() : 0,
+                                                expected.size() > 1 ? *(expected.begin() + 1) : 0))
+    {
+    }
+
+    typedef std::function<bool(Nan::NAN_METHOD_ARGS_TYPE) > InitFunction;
+
+    class MethodArgBinding;
+    class CheckArguments;
+
+    inline MethodArgBinding::MethodArgBinding(int index, CheckArguments& parent)
+        : mArgIndex(index)
+        , mParent(parent)
+    {
+    }
+
+    inline MethodArgBinding& MethodArgBinding::IsBuffer()
+    {
+        mParent.AddAndClause([this](Nan::NAN_METHOD_ARGS_TYPE) {
+            return mParent.Expect(mArgIndex, ArgTrait::Buffer, "IsBuffer", ArgType::Buffer);
+        });
+        return *this;
+    }
+
+    inline MethodArgBinding& MethodArgBinding::IsFunction()
+    {
+        mParent.AddAndClause([this](Nan::NAN_METHOD_ARGS_TYPE) {
+            return mParent.Expect(mArgIndex, ArgTrait::Function, "IsFunction", ArgType::Function);
+        });
+        return *this;
+    }
+
+    inline MethodArgBinding& MethodArgBinding::IsArray()
+    {
+        mParent.AddAndClause([this](Nan::NAN_METHOD_ARGS_TYPE) {
+            return mParent.Expect(mArgIndex, ArgTrait::Array, "IsArray", ArgType::Array);
+        });
+        return *this;
+    }
+
+    inline MethodArgBinding& MethodArgBinding::IsObject()
+    {
+        mParent.AddAndClause([this](Nan::NAN_METHOD_ARGS_TYPE) {
+            return mParent.Expect(mArgIndex, ArgTrait::Object, "IsObject", ArgType::Object);
+        });
+        return *this;
+    }
+
+    inline MethodArgBinding& MethodArgBinding::MaxLength(size_t maxLength)
+    {
+        mParent.AddAndClause([this, maxLength](Nan::NAN_METHOD_ARGS_TYPE args) {
+            v8::Local<v8::String> str;
+            if (!mParent.Validating() || (StringArgument(args[mArgIndex], str) && Utf8FitsWithin(str, maxLength)))
+                return true;
+
+            return mParent.Fail(CheckFailure::Violation(CheckErrorCode::Check, mArgIndex, "MaxLength", ArgType::String, args[mArgIndex]));
+        });
+        return *this;
+    }
+
+    inline MethodArgBinding& MethodArgBinding::IsString()
+    {
+        mParent.AddAndClause([this](Nan::NAN_METHOD_ARGS_TYPE) {
+            return mParent.Expect(mArgIndex, ArgTrait::String | ArgTrait::StringObject, "IsString", ArgType::String);
+        });
+        return *this;
+    }
+
+    inline MethodArgBinding& MethodArgBinding::NotNull()
+    {
+        mParent.AddAndClause([this](Nan::NAN_METHOD_ARGS_TYPE) {
+            if (!mParent.Validating() || !mParent.Fingerprint().Is(mArgIndex, ArgTrait::Null))
+                return true;
+
+            return mParent.Fail(CheckFailure::Violation(CheckErrorCode::Check, mArgIndex, "NotNull", ArgType::Unknown, ArgType::Null));
+        });
+        return *this;
+    }
+
+    inline CheckArguments::CheckArguments(Nan::NAN_METHOD_ARGS_TYPE args, const char * method)
+        : m_args(args)
+        , m_init([](Nan::NAN_METHOD_ARGS_TYPE args) { return true; })
+        , m_error(0)
+        , m_failureOut(0)
+        , m_sampleRate(-1)
+        , m_validating(true)
+#if NANCHECK_ENABLE_METRICS
+        , m_method(method)
+#endif
+    {
+        IsolateContext::Current();
+    }
+
+
+    inline CheckArguments& CheckArguments::ArgumentsCount(int count)
+    {
+        return AddAndClause([this, count](Nan::NAN_METHOD_ARGS_TYPE args)
+        {
+            if (m_validating && args.Length() != count)
+                return Fail(CheckFailure::ArgumentsCount(args.Length(), count, count));
+
+            return true;
+        });
+    }
+
+    inline CheckArguments& CheckArguments::ArgumentsCount(int argsCount1, int argsCount2)
+    {
+        return AddAndClause([this, argsCount1, argsCount2](Nan::NAN_METHOD_ARGS_TYPE args)
+        {
+            if (m_validating && args.Length() != argsCount1 && args.Length() != argsCount2)
+                return Fail(CheckFailure::ArgumentsCount(args.Length(), argsCount1, argsCount2));
+
+            return true;
+        });
+    }
+
+    inline MethodArgBinding CheckArguments::Argument(int index)
+    {
+        return MethodArgBinding(index, *this);
+    }
+
+    inline CheckArguments& CheckArguments::Error(std::string * error)
+    {
+        m_error = error;
+        return *this;
+    }
+
+    inline CheckArguments& CheckArguments::Failure(CheckFailure * failure)
+    {
+        m_failureOut = failure;
+        return *this;
+    }
+
+    inline CheckArguments& CheckArguments::Sampled(unsigned rate)
+    {
+        m_sampleRate = static_cast<int>(std::min<unsigned>(rate, std::numeric_limits<int>::max()));
+        return *this;
+    }
+
+    inline CheckArguments& CheckArguments::Trusted()
+    {
+        return Sampled(0);
+    }
+
+    inline bool CheckArguments::Validating() const
+    {
+        return m_validating;
+    }
+
+    inline bool CheckArguments::Fail(const CheckFailure& failure)
+    {
+        m_failure = failure;
+        return false;
+    }
+
+    inline const ArgumentFingerprint& CheckArguments::Fingerprint() const
+    {
+        return m_fingerprint;
+    }
+
+    inline bool CheckArguments::Expect(int argIndex, uint16_t traits, const char * check, ArgType expected)
+    {
+        if (!m_validating || m_fingerprint.Is(argIndex, traits))
+            return true;
+
+        return Fail(CheckFailure::Violation(CheckErrorCode::Check, argIndex, check, expected, m_fingerprint.Type(argIndex)));
+    }
+
+    /**
+     * Unwind all fluent calls. Built-in clauses report failures through Fail() without throwing;
+     * CheckException is still accepted from custom clauses.
+     */
+    inline CheckArguments::operator bool() const
+    {
+        CheckFailure failure;
+
+#if NANCHECK_ENABLE_METRICS
+        if (m_method)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            bool passed = Evaluate(failure);
+            std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+            CheckMetrics::Record(m_method, passed ? nullptr : &failure, static_cast<uint64_t>(elapsed.count()));
+            return passed;
+        }
+#endif
+        return Evaluate(failure);
+    }
+
+    inline bool CheckArguments::Evaluate(CheckFailure& failure) const
+    {
+        m_validating = CheckSampling::Sample(m_sampleRate < 0 ? CheckSampling::Rate() : static_cast<unsigned>(m_sampleRate));
+        if (m_validating)
+            m_fingerprint.Classify(m_args);
+
+        try
+        {
+            if (m_init(m_args))
+                return true;
+
+            failure = m_failure;
+        }
+        catch (CheckException& exc)
+        {
+            failure = exc.Failure();
+            if (m_error)
+            {
+                *m_error = exc.what();
+            }
+            if (m_failureOut)
+            {
+                *m_failureOut = failure;
+            }
+            return false;
+        }
+        catch (...)
+        {
+            failure.mCode = CheckErrorCode::Unknown;
+        }
+
+        CheckReport(m_error).Fail(failure);
+        return CheckReport(m_failureOut).Fail(failure);
+    }
+
+    inline std::atomic<unsigned>& CheckSampling::GlobalRate()
+    {
+        static std::atomic<unsigned> rate(NANCHECK_VALIDATION_SAMPLE_RATE);
+        return rate;
+    }
+
+    inline void CheckSampling::SetRate(unsigned rate)
+    {
+        GlobalRate().store(rate, std::memory_order_relaxed);
+    }
+
+    inline unsigned CheckSampling::Rate()
+    {
+        return GlobalRate().load(std::memory_order_relaxed);
+    }
+
+    inline bool CheckSampling::Sample(unsigned rate)
+    {
+#if NANCHECK_ALWAYS_VALIDATE
+        (void)rate;
+        return true;
+#else
+        if (rate <= 1)
+            return rate == 1;
+
+        // xorshift32 per thread; random rather than every N-th call, so that methods sharing
+        // the generator cannot fall into a pattern where one of them is never checked
+        static NANCHECK_THREAD_LOCAL uint32_t state = 0x9E3779B9u;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % rate == 0;
+#endif
+    }
+
+    inline CheckArguments& CheckArguments::AddAndClause(InitFunction rightCondition)
+    {
+        InitFunction prevInit = m_init;
+        InitFunction newInit = [prevInit, rightCondition](Nan::NAN_METHOD_ARGS_TYPE args) {
+            return prevInit(args) && rightCondition(args);
+        };
+        m_init = newInit;
+        return *this;
+    }
+
+    inline CheckArguments Check(Nan::NAN_METHOD_ARGS_TYPE args)
+    {
+        return std::move(CheckArguments(args));
+    }
+
+    inline CheckArguments Check(Nan::NAN_METHOD_ARGS_TYPE args, const char * method)
+    {
+        return std::move(CheckArguments(args, method));
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+#if NANCHECK_ENABLE_METRICS
+    inline MethodMetrics * CheckMetrics::Table()
+    {
+        // Zero-initialized static storage, so no construction happens at run time
+        static MethodMetrics table[NANCHECK_METRICS_CAPACITY];
+        return table;
+    }
+
+    inline size_t CheckMetrics::Hash(const char * name)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (; *name; name++)
+            hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+        return hash;
+    }
+
+    inline bool CheckMetrics::SameName(const char * a, const char * b)
+    {
+        return a == b || std::strcmp(a, b) == 0;
+    }
+
+    inline MethodMetrics * CheckMetrics::Find(const char * method)
+    {
+        static_assert((NANCHECK_METRICS_CAPACITY & (NANCHECK_METRICS_CAPACITY - 1)) == 0, "NANCHECK_METRICS_CAPACITY must be a power of two");
+
+        MethodMetrics * table = Table();
+        size_t hash = Hash(method);
+
+        for (size_t probe = 0; probe < NANCHECK_METRICS_CAPACITY; probe++)
+        {
+            MethodMetrics& slot = table[(hash + probe) & (NANCHECK_METRICS_CAPACITY - 1)];
+
+            const char * name = slot.mName.load(std::memory_order_acquire);
+            if (name == nullptr && slot.mName.compare_exchange_strong(name, method, std::memory_order_acq_rel))
+                return &slot;
+
+            if (SameName(name, method))
+                return &slot;
+        }
+
+        return nullptr;
+    }
+
+    inline void CheckMetrics::Record(const char * method, const CheckFailure * failure, uint64_t nanoseconds)
+    {
+        MethodMetrics * metrics = Find(method);
+        if (!metrics)
+            return;
+
+        metrics->mCalls.fetch_add(1, std::memory_order_relaxed);
+
+        int bucket = 0;
+        for (uint64_t bound = nanoseconds >> 8; bound && bucket < MethodMetrics::kLatencyBuckets - 1; bound >>= 1)
+            bucket++;
+        metrics->mLatency[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        if (!failure)
+            return;
+
+        metrics->mFailures.fetch_add(1, std::memory_order_relaxed);
+
+        const char * check = failure->mCode == CheckErrorCode::ArgumentsCount ? "ArgumentsCount"
+                           : failure->mCode == CheckErrorCode::Overload ? "Overload"
+                           : failure->mCheck ? failure->mCheck
+                           : "Unknown";
+        int row = failure->mArgIndex < 0 ? 0 : std::min(failure->mArgIndex, MethodMetrics::kArguments - 1) + 1;
+
+        for (int i = 0; i < MethodMetrics::kChecks; i++)
+        {
+            const char * name = metrics->mFailedCheck[row][i].load(std::memory_order_acquire);
+            if (name == nullptr && metrics->mFailedCheck[row][i].compare_exchange_strong(name, check, std::memory_order_acq_rel))
+                name = check;
+
+            if (SameName(name, check))
+            {
+                metrics->mFailedCount[row][i].fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    inline v8::Local<v8::Object> CheckMetrics::Snapshot()
+    {
+        v8::Local<v8::Object> snapshot = Nan::New<v8::Object>();
+        MethodMetrics * table = Table();
+
+        for (int m = 0; m < NANCHECK_METRICS_CAPACITY; m++)
+        {
+            const MethodMetrics& metrics = table[m];
+
+            const char * name = metrics.mName.load(std::memory_order_acquire);
+            if (!name)
+                continue;
+
+            v8::Local<v8::Object> method = Nan::New<v8::Object>();
+            Nan::Set(method, Nan::New("calls").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(metrics.mCalls.load(std::memory_order_relaxed))));
+            Nan::Set(method, Nan::New("failures").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(metrics.mFailures.load(std::memory_order_relaxed))));
+
+            v8::Local<v8::Array> errors = Nan::New<v8::Array>();
+            uint32_t errorsCount = 0;
+            for (int row = 0; row <= MethodMetrics::kArguments; row++)
+            {
+                for (int i = 0; i < MethodMetrics::kChecks; i++)
+                {
+                    const char * check = metrics.mFailedCheck[row][i].load(std::memory_order_acquire);
+                    if (!check)
+                        break;
+
+                    v8::Local<v8::Object> error = Nan::New<v8::Object>();
+                    Nan::Set(error, Nan::New("argument").ToLocalChecked(), Nan::New<v8::Integer>(row - 1));
+                    Nan::Set(error, Nan::New("check").ToLocalChecked(), Nan::New(check).ToLocalChecked());
+                    Nan::Set(error, Nan::New("count").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(metrics.mFailedCount[row][i].load(std::memory_order_relaxed))));
+                    Nan::Set(errors, errorsCount++, error);
+                }
+            }
+            Nan::Set(method, Nan::New("errors").ToLocalChecked(), errors);
+
+            v8::Local<v8::Object> latency = Nan::New<v8::Object>();
+            for (int bucket = 0; bucket < MethodMetrics::kLatencyBuckets; bucket++)
+            {
+                std::string bound = bucket + 1 < MethodMetrics::kLatencyBuckets ? std::to_string(256ull << bucket) : "Infinity";
+                Nan::Set(latency, Nan::New(bound).ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(metrics.mLatency[bucket].load(std::memory_order_relaxed))));
+            }
+            Nan::Set(method, Nan::New("latency").ToLocalChecked(), latency);
+
+            Nan::Set(snapshot, Nan::New(name).ToLocalChecked(), method);
+        }
+
+        return snapshot;
+    }
+#endif
+
+    inline NAN_METHOD(GetCheckMetrics)
+    {
+#if NANCHECK_ENABLE_METRICS
+        info.GetReturnValue().Set(CheckMetrics::Snapshot());
+#endif
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    inline bool SchemaIsBuffer(const SchemaClause&, v8::Local<v8::Value> value, void *)
+    {
+        return node::Buffer::HasInstance(value);
+    }
+
+    inline bool SchemaIsFunction(const SchemaClause&, v8::Local<v8::Value> value, void *)
+    {
+        return value->IsFunction();
+    }
+
+    inline bool SchemaIsString(const SchemaClause&, v8::Local<v8::Value> value, void *)
+    {
+        return value->IsString() || value->IsStringObject();
+    }
+
+    inline bool SchemaNotNull(const SchemaClause&, v8::Local<v8::Value> value, void *)
+    {
+        return !value->IsNull();
+    }
+
+    inline bool SchemaIsArray(const SchemaClause&, v8::Local<v8::Value> value, void *)
+    {
+        return value->IsArray();
+    }
+
+    inline bool SchemaIsObject(const SchemaClause&, v8::Local<v8::Value> value, void *)
+    {
+        return value->IsObject();
+    }
+
+    inline bool SchemaMaxLength(const SchemaClause& clause, v8::Local<v8::Value> value, void *)
+    {
+        v8::Local<v8::String> str;
+        return StringArgument(value, str) && Utf8FitsWithin(str, static_cast<size_t>(clause.mCount1));
+    }
+
+    inline SchemaBuilder::SchemaBuilder()
+    {
+    }
+
+    inline SchemaBuilder& SchemaBuilder::ArgumentsCount(int count)
+    {
+        return ArgumentsCount(count, count);
+    }
+
+    inline SchemaBuilder& SchemaBuilder::ArgumentsCount(int argsCount1, int argsCount2)
+    {
+        SchemaClause clause = { "ArgumentsCount", ArgType::Unknown, -1, argsCount1, argsCount2, -1, nullptr, nullptr, nullptr };
+        return AddClause(clause);
+    }
+
+    inline SchemaArgBinding SchemaBuilder::Argument(int index)
+    {
+        return SchemaArgBinding(index, *this);
+    }
+
+    inline SchemaBuilder& SchemaBuilder::AddClause(const SchemaClause& clause)
+    {
+        mClauses.push_back(clause);
+        return *this;
+    }
+
+    inline SchemaArgBinding::SchemaArgBinding(int index, SchemaBuilder& parent)
+        : mArgIndex(index)
+        , mParent(parent)
+    {
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::AddCheck(const char * name, ArgType expected, SchemaClauseFunction check)
+    {
+        SchemaClause clause = { name, expected, mArgIndex, 0, 0, -1, check, nullptr, nullptr };
+        mParent.AddClause(clause);
+        return *this;
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::IsBuffer()
+    {
+        return AddCheck("IsBuffer", ArgType::Buffer, &SchemaIsBuffer);
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::IsFunction()
+    {
+        return AddCheck("IsFunction", ArgType::Function, &SchemaIsFunction);
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::IsString()
+    {
+        return AddCheck("IsString", ArgType::String, &SchemaIsString);
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::NotNull()
+    {
+        return AddCheck("NotNull", ArgType::Unknown, &SchemaNotNull);
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::IsArray()
+    {
+        return AddCheck("IsArray", ArgType::Array, &SchemaIsArray);
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::IsObject()
+    {
+        return AddCheck("IsObject", ArgType::Object, &SchemaIsObject);
+    }
+
+    inline SchemaArgBinding& SchemaArgBinding::MaxLength(size_t maxLength)
+    {
+        SchemaClause clause = { "MaxLength", ArgType::String, mArgIndex,
+                                static_cast<int>(std::min<size_t>(maxLength, std::numeric_limits<int>::max())), 0, -1, &SchemaMaxLength, nullptr, nullptr };
+        mParent.AddClause(clause);
+        return *this;
+    }
+
+    inline CheckSchema::CheckSchema(const SchemaBuilder& builder)
+        : mClauses(builder.mClauses)
+        , mBindingTypes(builder.mBindingTypes)
+    {
+    }
+
+    inline size_t CheckSchema::BindingsCount() const
+    {
+        return mBindingTypes.size();
+    }
+
+    inline bool CheckSchema::Evaluate(Nan::NAN_METHOD_ARGS_TYPE args, CheckReport report,
+                                      void * const * targets, const void * const * types, size_t count) const
+    {
+        bool typesMatch = count == mBindingTypes.size();
+        for (size_t i = 0; typesMatch && i < count; i++)
+        {
+            typesMatch = types[i] == mBindingTypes[i];
+        }
+
+        assert(typesMatch && "CheckSchema::Check targets do not match Bind<T>() declarations");
+        if (!typesMatch)
+        {
+            CheckFailure failure;
+            failure.mCode = CheckErrorCode::Unknown;
+            return report.Fail(failure);
+        }
+
+        // Schemas follow the process-wide rate; unchecked evaluations only bind
+        bool validating = CheckSampling::Sample(CheckSampling::Rate());
+
+        for (const SchemaClause& clause : mClauses)
+        {
+            if (!validating && clause.mSlot < 0)
+                continue;
+
+            if (clause.mArgIndex < 0)
+            {
+                if (args.Length() != clause.mCount1 && args.Length() != clause.mCount2)
+                    return report.Fail(CheckFailure::ArgumentsCount(args.Length(), clause.mCount1, clause.mCount2));
+            }
+            else
+            {
+                void * target = clause.mSlot < 0 ? nullptr : targets[clause.mSlot];
+                if (!clause.mFunction(clause, args[clause.mArgIndex], target))
+                {
+                    CheckErrorCode code = clause.mSlot < 0 ? CheckErrorCode::Check : CheckErrorCode::Bind;
+                    CheckFailure failure = CheckFailure::Violation(code, clause.mArgIndex, clause.mName, clause.mExpected, args[clause.mArgIndex]);
+                    failure.mProperty = clause.mProperty;
+                    return report.Fail(failure);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    inline SchemaBuilder Schema()
+    {
+        return SchemaBuilder();
+    }
+
+    inline ProgressPolicy ProgressPolicy::Latest()
+    {
+        ProgressPolicy policy = { ProgressCoalescing::Latest, 0 };
+        return policy;
+    }
+
+    inline ProgressPolicy ProgressPolicy::Batch()
+    {
+        ProgressPolicy policy = { ProgressCoalescing::Batch, 0 };
+        return policy;
+    }
+
+    inline ProgressPolicy ProgressPolicy::Throttle(unsigned intervalMs)
+    {
+        ProgressPolicy policy = { ProgressCoalescing::Throttle, intervalMs };
+        return policy;
+    }
+
+    inline SchemaProperty SchemaArgBinding::Property(const char * name)
+    {
+        return SchemaProperty(name, mParent, mArgIndex);
+    }
+
+    inline SchemaProperty::SchemaProperty(const char * name, SchemaBuilder& parent, int argIndex)
+        : mName(name)
+        , mParent(parent)
+        , mArgIndex(argIndex)
+    {
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+
+    inline v8::Local<v8::String> NewInternalizedString(const char * value)
+    {
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+        return v8::String::NewFromUtf8(v8::Isolate::GetCurrent(), value, v8::NewStringType::kInternalized).ToLocalChecked();
+#elif NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION
+        return v8::String::NewFromUtf8(v8::Isolate::GetCurrent(), value, v8::String::kInternalizedString);
+#else
+        return v8::String::NewSymbol(value);
+#endif
+    }
+
+    inline PropertyKeyCache::PropertyKeyCache()
+    {
+    }
+
+    inline PropertyKeyCache::~PropertyKeyCache()
+    {
+        for (auto& key : mKeys)
+        {
+            key.second->mKey.Reset();
+            delete key.second;
+        }
+    }
+
+    inline bool PropertyKeyCache::Name::operator==(const Name& other) const
+    {
+        return mLength == other.mLength && std::memcmp(mData, other.mData, mLength) == 0;
+    }
+
+    inline size_t PropertyKeyCache::NameHash::operator()(const Name& name) const
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < name.mLength; i++)
+            hash = (hash ^ static_cast<uint8_t>(name.mData[i])) * 16777619u;
+        return hash;
+    }
+
+    inline PropertyKeyCache * PropertyKeyCache::Current()
+    {
+        return &IsolateContext::Current()->PropertyKeys();
+    }
+
+    inline v8::Local<v8::String> PropertyKeyCache::Get(const char * name)
+    {
+        PropertyKeyCache * cache = Current();
+
+        auto it = cache->mKeys.find(Name{ name, std::strlen(name) });
+        if (it != cache->mKeys.end())
+            return Nan::New(it->second->mKey);
+
+        v8::Local<v8::String> key = NewInternalizedString(name);
+
+        Entry * entry = new Entry();
+        entry->mName = name;
+        entry->mKey.Reset(key);
+        cache->mKeys[Name{ entry->mName.c_str(), entry->mName.size() }] = entry;
+        return key;
+    }
+
+    inline PropertyKey::PropertyKey(const char * name)
+        : mName(name)
+    {
+    }
+
+    inline CallbackPool::CallbackPool()
+        : mSlotsCount(0)
+        , mInUse(0)
+        , mHighWaterMark(0)
+    {
+    }
+
+    inline CallbackPool::~CallbackPool()
+    {
+        mSlots.Reset();
+        mContext.Reset();
+    }
+
+    inline CallbackPool * CallbackPool::Current()
+    {
+        return &IsolateContext::Current()->Callbacks();
+    }
+
+    inline void CallbackPool::Store(int slot, v8::Local<v8::Value> value)
+    {
+        Nan::HandleScope scope;
+
+        if (mSlots.IsEmpty())
+        {
+            mSlots.Reset(Nan::New<v8::Array>());
+            mContext.Reset(Nan::GetCurrentContext());
+        }
+
+        v8::Local<v8::Context> context = Nan::New(mContext);
+        v8::Context::Scope contextScope(context);
+        Nan::Set(Nan::New(mSlots), static_cast<uint32_t>(slot), value);
+    }
+
+    inline int CallbackPool::Acquire(v8::Local<v8::Function> function)
+    {
+        CallbackPool * pool = Current();
+
+        int slot;
+        if (pool->mFree.empty())
+        {
+            slot = pool->mSlotsCount++;
+        }
+        else
+        {
+            slot = pool->mFree.back();
+            pool->mFree.pop_back();
+        }
+
+        pool->Store(slot, function);
+        pool->mHighWaterMark = std::max(pool->mHighWaterMark, ++pool->mInUse);
+        return slot;
+    }
+
+    inline void CallbackPool::Assign(int slot, v8::Local<v8::Function> function)
+    {
+        Current()->Store(slot, function);
+    }
+
+    inline void CallbackPool::Release(int slot)
+    {
+        if (slot < 0)
+            return;
+
+        CallbackPool * pool = Current();
+
+        // Drops the function right away, so that the pool does not keep it alive
+        pool->Store(slot, Nan::Undefined());
+        pool->mFree.push_back(slot);
+        pool->mInUse--;
+    }
+
+    inline v8::Local<v8::Function> CallbackPool::Get(int slot)
+    {
+        return Nan::Get(Nan::New(Current()->mSlots), static_cast<uint32_t>(slot)).ToLocalChecked().As<v8::Function>();
+    }
+
+    inline CallbackPool::Stats CallbackPool::Statistics()
+    {
+        CallbackPool * pool = Current();
 
-        MethodArgBinding(int index, CheckArguments& parent);
+        Stats stats = { pool->mFree.size(), pool->mInUse, pool->mHighWaterMark };
+        return stats;
+    }
 
-        MethodArgBinding& IsBuffer();
-        MethodArgBinding& IsFunction();
-        MethodArgBinding& IsString();
-        MethodArgBinding& NotNull();
-        MethodArgBinding& IsArray();
-        MethodArgBinding& IsObject();
+    inline NAN_METHOD(GetCallbackPoolStats)
+    {
+        CallbackPool::Stats stats = CallbackPool::Statistics();
 
-        template <typename T>
-        ArgStringEnum<T> StringEnum(std::initializer_list< std::pair<const char*, T> > possibleValues);
+        v8::Local<v8::Object> result = Nan::New<v8::Object>();
+        Nan::Set(result, Nan::New<v8::String>("size").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(stats.mSize)));
+        Nan::Set(result, Nan::New<v8::String>("inUse").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(stats.mInUse)));
+        Nan::Set(result, Nan::New<v8::String>("highWaterMark").ToLocalChecked(), Nan::New<v8::Number>(static_cast<double>(stats.mHighWaterMark)));
+        info.GetReturnValue().Set(result);
+    }
 
-        template <typename T>
-        CheckArguments& Bind(v8::Local<T>& value);
+    //////////////////////////////////////////////////////////////////////////
 
-        template <typename T>
-        CheckArguments& Bind(T& value);
+    inline IsolateContext::IsolateContext(v8::Isolate * isolate)
+        : mIsolate(isolate)
+    {
+    }
 
-        template <typename T1, typename T2>
-        CheckArguments& BindAny(T1& value1, T2& value2);
+    inline IsolateContext::~IsolateContext()
+    {
+    }
 
-    private:
-        int              mArgIndex;
-        CheckArguments&  mParent;
-    };
+    inline IsolateContext::Cached& IsolateContext::ThreadCache()
+    {
+        static NANCHECK_THREAD_LOCAL Cached cached = { nullptr, nullptr, 0 };
+        return cached;
+    }
 
-    //////////////////////////////////////////////////////////////////////////
-    // Template functions implementation
+    inline IsolateContext::Registry& IsolateContext::Contexts()
+    {
+        // Never destroyed, so that cleanup hooks running at process exit still find it
+        static Registry * registry = new Registry();
+        return *registry;
+    }
 
-    template <typename T>
-    inline CheckArguments& MethodArgBinding::Bind(v8::Local<T>& value)
+    inline IsolateContext * IsolateContext::Current()
     {
-        return mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
-            value = args[mArgIndex].As<T>();
-            return true;
-        });
+        return Current(v8::Isolate::GetCurrent());
     }
 
+    inline IsolateContext * IsolateContext::Current(v8::Isolate * isolate)
+    {
+        // The generation changes whenever a context is destroyed, so a cached context is never used after
+        // its isolate is gone, even when a new isolate is allocated at the same address
+        Cached& cached = ThreadCache();
+        if (cached.mIsolate == isolate && cached.mGeneration == Contexts().mGeneration.load(std::memory_order_acquire))
+            return cached.mContext;
 
-    template <typename T>
-    inline CheckArguments& MethodArgBinding::Bind(T& value)
+        return Lookup(isolate);
+    }
+
+    inline IsolateContext * IsolateContext::Lookup(v8::Isolate * isolate)
     {
-        return mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
-            try
+        Registry& registry = Contexts();
+        IsolateContext * context;
+        bool created = false;
+        unsigned generation;
+        {
+            std::lock_guard<std::mutex> lock(registry.mLock);
+
+            auto it = registry.mContexts.find(isolate);
+            if (it != registry.mContexts.end())
             {
-                value = Nan::Marshal<T>(args[mArgIndex]);
-                return true;
+                context = it->second;
             }
-            catch (...)
+            else
             {
-                return false;
+                context = new IsolateContext(isolate);
+                registry.mContexts[isolate] = context;
+                created = true;
             }
-        });
+            generation = registry.mGeneration.load(std::memory_order_relaxed);
+        }
+
+#if NANCHECK_CLEANUP_HOOKS
+        if (created)
+            node::AddEnvironmentCleanupHook(isolate, &IsolateContext::Destroy, context);
+#else
+        (void)created;
+#endif
+
+        Cached& cached = ThreadCache();
+        cached.mIsolate = isolate;
+        cached.mContext = context;
+        cached.mGeneration = generation;
+        return context;
     }
 
-    template <typename T1, typename T2>
-    inline CheckArguments& MethodArgBinding::BindAny(T1& value1, T2& value2)
+    inline void IsolateContext::Destroy(void * arg)
     {
-        return mParent.AddAndClause([this, &value1, &value2](Nan::NAN_METHOD_ARGS_TYPE args) {
-            value1 = Nan::Marshal<T1>(args[mArgIndex]);
-            value2 = Nan::Marshal<T2>(args[mArgIndex]);
-            return true;
-        });
+        IsolateContext * context = static_cast<IsolateContext *>(arg);
+
+        Registry& registry = Contexts();
+        {
+            std::lock_guard<std::mutex> lock(registry.mLock);
+
+            registry.mContexts.erase(context->mIsolate);
+            registry.mGeneration.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        // Runs on the isolate's thread while the isolate is still alive, so persistent handles can be reset
+        delete context;
     }
 
-    template <typename T>
-    inline ArgStringEnum<T> MethodArgBinding::StringEnum(std::initializer_list< std::pair<const char*, T> > possibleValues)
+    inline size_t IsolateContext::Count()
     {
-        return std::move(ArgStringEnum<T>(possibleValues, IsString(), mArgIndex));
+        Registry& registry = Contexts();
+        std::lock_guard<std::mutex> lock(registry.mLock);
+        return registry.mContexts.size();
     }
 
-    //////////////////////////////////////////////////////////////////////////
+    inline v8::Isolate * IsolateContext::Isolate() const
+    {
+        return mIsolate;
+    }
 
-    template <typename T>
-    inline ArgStringEnum<T>::ArgStringEnum(
-        std::initializer_list< std::pair<const char*, T> > possibleValues,
-        MethodArgBinding& owner, int argIndex)
-        : mPossibleValues(possibleValues.begin(), possibleValues.end())
-        , mOwner(owner)
-        , mArgIndex(argIndex)
+    inline PropertyKeyCache& IsolateContext::PropertyKeys()
     {
+        return mPropertyKeys;
     }
 
-    template <typename T>
-    inline CheckArguments& ArgStringEnum<T>::Bind(T& value)
+    inline CallbackPool& IsolateContext::Callbacks()
     {
-        return mOwner.mParent.AddAndClause([this, &value](Nan::NAN_METHOD_ARGS_TYPE args) {
-            std::string key = Marshal<std::string>(args[mArgIndex]);
-            return TryMatchStringEnum(key, value);
-        });
+        return mCallbacks;
     }
 
-    template <typename T>
-    inline bool ArgStringEnum<T>::TryMatchStringEnum(const std::string& key, T& outValue) const
+    inline PooledCallback::PooledCallback()
+        : mSlot(-1)
+    {
+    }
+
+    inline PooledCallback::PooledCallback(PooledCallback&& other)
+        : mSlot(other.mSlot)
+    {
+        other.mSlot = -1;
+    }
+
+    inline PooledCallback& PooledCallback::operator=(PooledCallback&& other)
     {
-        auto it = mPossibleValues.find(key);
-        if (it != mPossibleValues.end())
+        if (this != &other)
         {
-            outValue = it->second;
-            return true;
+            Reset();
+            mSlot = other.mSlot;
+            other.mSlot = -1;
         }
+        return *this;
+    }
 
-        return false;
+    inline PooledCallback::~PooledCallback()
+    {
+        Reset();
     }
 
-}
+    inline void PooledCallback::Reset(v8::Local<v8::Function> function)
+    {
+        if (mSlot >= 0)
+            CallbackPool::Assign(mSlot, function);
+        else
+            mSlot = CallbackPool::Acquire(function);
+    }
 
-namespace Nan
-{
+    inline void PooledCallback::Reset()
+    {
+        CallbackPool::Release(mSlot);
+        mSlot = -1;
+    }
 
-    inline CheckException::CheckException(const std::string& msg)
-        : std::runtime_error(nullptr)
-        , mMessage(msg)
+    inline bool PooledCallback::IsEmpty() const
     {
+        return mSlot < 0;
     }
 
-    inline CheckException::CheckException(int actual, int expected)
-        : std::runtime_error(nullptr)
-        , mMessage("Invalid number of arguments passed to a function")
+    inline v8::Local<v8::Function> PooledCallback::GetFunction() const
     {
+        return CallbackPool::Get(mSlot);
     }
 
-    inline CheckException::CheckException(int actual, const std::initializer_list<int>& expected)
-        : std::runtime_error(nullptr)
-        , mMessage("Invalid number of arguments passed to a function")
+    inline Nan::MaybeLocal<v8::Value> PooledCallback::Call(int argc, v8::Local<v8::Value> argv[], Nan::AsyncResource * resource) const
     {
+        return resource->runInAsyncScope(Nan::GetCurrentContext()->Global(), GetFunction(), argc, argv);
     }
 
-    typedef std::function<bool(Nan::NAN_METHOD_ARGS_TYPE) > InitFunction;
+    inline bool ArgBinder<PooledCallback>::Bind(v8::Local<v8::Value> value, PooledCallback& outValue)
+    {
+        if (!value->IsFunction())
+            return false;
 
-    class MethodArgBinding;
-    class CheckArguments;
+        outValue.Reset(value.As<v8::Function>());
+        return true;
+    }
 
-    inline MethodArgBinding::MethodArgBinding(int index, CheckArguments& parent)
-        : mArgIndex(index)
-        , mParent(parent)
+    inline const char * PropertyKey::Name() const
     {
+        return mName;
     }
 
-    inline MethodArgBinding& MethodArgBinding::IsBuffer()
+    inline v8::Local<v8::String> PropertyKey::Get() const
     {
-        auto bind = [this](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            bool isBuf = node::Buffer::HasInstance(args[mArgIndex]);
+        return PropertyKeyCache::Get(mName);
+    }
 
-            if (!isBuf)
-                throw CheckException(std::string("Argument ") + std::to_string(mArgIndex) + " violates IsBuffer check");
-            return true;
-        };
+    inline ArgProperty MethodArgBinding::Property(const char * name)
+    {
+        return ArgProperty(name, *this, mArgIndex);
+    }
 
-        mParent.AddAndClause(bind);
-        return *this;
+    inline ArgProperty MethodArgBinding::Property(const PropertyKey& key)
+    {
+        return ArgProperty(key.Name(), *this, mArgIndex);
     }
 
-    inline MethodArgBinding& MethodArgBinding::IsFunction()
+    inline ArgProperty::ArgProperty(const char * name, MethodArgBinding& owner, int argIndex)
+        : mName(name)
+        , mOwner(owner)
+        , mArgIndex(argIndex)
     {
-        auto bind = [this](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            bool isFn = args[mArgIndex]->IsFunction();
+    }
 
-            if (!isFn)
-                throw CheckException(std::string("Argument ") + std::to_string(mArgIndex) + " violates IsFunction check");
+    //////////////////////////////////////////////////////////////////////////
 
+    inline bool StringArgument(v8::Local<v8::Value> value, v8::Local<v8::String>& outValue)
+    {
+        if (value->IsString())
+        {
+            outValue = value.As<v8::String>();
             return true;
-        };
-        mParent.AddAndClause(bind);
-        return *this;
+        }
+
+        if (!value->IsStringObject())
+            return false;
+
+        outValue = value.As<v8::StringObject>()->ValueOf();
+        return true;
     }
 
-    inline MethodArgBinding& MethodArgBinding::IsArray()
+    inline ssize_t Utf8LengthWithin(v8::Local<v8::String> str, size_t maxLength)
     {
-        auto bind = [this](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            bool isArr = args[mArgIndex]->IsArray();
-            if (!isArr)
-                throw CheckException(std::string("Argument ") + std::to_string(mArgIndex) + " violates IsArray check");
+        // Every UTF-16 unit takes 1 to 3 UTF-8 bytes
+        size_t units = static_cast<size_t>(str->Length());
+        if (units > maxLength)
+            return -1;
 
-            return true;
-        };
-        mParent.AddAndClause(bind);
-        return *this;
+        ssize_t length = Nan::DecodeBytes(str, Nan::UTF8);
+        return length < 0 || static_cast<size_t>(length) > maxLength ? -1 : length;
     }
 
-    inline MethodArgBinding& MethodArgBinding::IsObject()
+    inline bool Utf8FitsWithin(v8::Local<v8::String> str, size_t maxLength)
     {
-        auto bind = [this](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            bool isArr = args[mArgIndex]->IsObject();
-            if (!isArr)
-                throw CheckException(std::string("Argument ") + std::to_string(mArgIndex) + " violates IsObject check");
+        // Every UTF-16 unit takes 1 to 3 UTF-8 bytes
+        size_t units = static_cast<size_t>(str->Length());
+        if (units > maxLength)
+            return false;
 
-            return true;
-        };
-        mParent.AddAndClause(bind);
-        return *this;
+        return units * 3 <= maxLength || Utf8LengthWithin(str, maxLength) >= 0;
     }
 
-    inline MethodArgBinding& MethodArgBinding::IsString()
+    inline bool ArgBinder<std::string>::Bind(v8::Local<v8::Value> value, std::string& outValue)
     {
-        auto bind = [this](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            bool isStr = args[mArgIndex]->IsString() || args[mArgIndex]->IsStringObject();
+        v8::Local<v8::String> str;
+        if (!StringArgument(value, str))
+            return false;
 
-            if (!isStr)
-                throw CheckException(std::string("Argument ") + std::to_string(mArgIndex) + " violates IsString check");
+        ssize_t length = Nan::DecodeBytes(str, Nan::UTF8);
+        if (length < 0)
+            return false;
 
-            return true;
-        };
-        mParent.AddAndClause(bind);
-        return *this;
+        outValue.resize(static_cast<size_t>(length));
+        if (length > 0)
+            Nan::DecodeWrite(&outValue[0], length, str, Nan::UTF8);
+        return true;
     }
 
-    inline MethodArgBinding& MethodArgBinding::NotNull()
+    inline OneByteString::OneByteString()
+        : mData(mInline)
+        , mLength(0)
+        , mExternal(false)
     {
-        auto bind = [this](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            if (args[mArgIndex]->IsNull())
-            {
-                throw CheckException(std::string("Argument ") + std::to_string(mArgIndex) + " violates NotNull check");
-            }
-            return true;
-        };
-        mParent.AddAndClause(bind);
-        return *this;
     }
 
-    inline CheckArguments::CheckArguments(Nan::NAN_METHOD_ARGS_TYPE args)
-        : m_args(args)
-        , m_init([](Nan::NAN_METHOD_ARGS_TYPE args) { return true; })
-        , m_error(0)
+    inline const char * OneByteString::Data() const
+    {
+        return mData;
+    }
+
+    inline size_t OneByteString::Length() const
     {
+        return mLength;
     }
 
+    inline bool OneByteString::IsExternal() const
+    {
+        return mExternal;
+    }
 
-    inline CheckArguments& CheckArguments::ArgumentsCount(int count)
+    inline bool ArgBinder<OneByteString>::Bind(v8::Local<v8::Value> value, OneByteString& outValue)
     {
-        return AddAndClause([count](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            if (args.Length() != count)
-                throw CheckException(args.Length(), count);
+        v8::Local<v8::String> str;
+        if (!StringArgument(value, str))
+            return false;
 
+#if NODE_MODULE_VERSION >= NODE_4_0_MODULE_VERSION
+        if (str->IsExternalOneByte())
+        {
+            const v8::String::ExternalOneByteStringResource * resource = str->GetExternalOneByteStringResource();
+            outValue.mData = resource->data();
+            outValue.mLength = resource->length();
+            outValue.mExternal = true;
             return true;
-        });
+        }
+#endif
+
+#if NODE_MODULE_VERSION > NODE_0_10_MODULE_VERSION
+        // IsOneByte() only looks at the representation, which may be two-byte for Latin-1 contents
+        if (!str->IsOneByte() && !str->ContainsOnlyOneByte())
+            return false;
+#else
+        if (str->MayContainNonAscii())
+            return false;
+#endif
+
+        size_t length = static_cast<size_t>(str->Length());
+        char * data = outValue.mInline;
+        if (length > OneByteString::kInlineCapacity)
+        {
+            outValue.mHeap.resize(length);
+            data = &outValue.mHeap[0];
+        }
+
+        Nan::DecodeWrite(data, length, str, Nan::BINARY);
+        outValue.mData = data;
+        outValue.mLength = length;
+        outValue.mExternal = false;
+        return true;
     }
 
-    inline CheckArguments& CheckArguments::ArgumentsCount(int argsCount1, int argsCount2)
+    inline bool SignatureArg<Arg::Buffer>::Bind(v8::Local<v8::Value> value, v8::Local<v8::Object>& outValue)
     {
-        return AddAndClause([argsCount1, argsCount2](Nan::NAN_METHOD_ARGS_TYPE args)
-        {
-            if (args.Length() != argsCount1 || args.Length() != argsCount2)
-                throw CheckException(args.Length(), { argsCount1, argsCount2 });
+        if (!node::Buffer::HasInstance(value))
+            return false;
 
-            return true;
-        });
+        outValue = value.As<v8::Object>();
+        return true;
     }
 
-    inline MethodArgBinding CheckArguments::Argument(int index)
+    inline bool SignatureArg<Arg::Function>::Bind(v8::Local<v8::Value> value, v8::Local<v8::Function>& outValue)
     {
-        return MethodArgBinding(index, *this);
+        if (!value->IsFunction())
+            return false;
+
+        outValue = value.As<v8::Function>();
+        return true;
     }
 
-    inline CheckArguments& CheckArguments::Error(std::string * error)
+    inline bool SignatureArg<Arg::String>::Bind(v8::Local<v8::Value> value, v8::Local<v8::String>& outValue)
     {
-        m_error = error;
-        return *this;
+        return StringArgument(value, outValue);
     }
 
-    /**
-     * Unwind all fluent calls
-     */
-    inline CheckArguments::operator bool() const
+    inline bool SignatureArg<Arg::Array>::Bind(v8::Local<v8::Value> value, v8::Local<v8::Array>& outValue)
     {
-        try
-        {
-            return m_init(m_args);
-        }
-        catch (CheckException& exc)
-        {
-            if (m_error)
-            {
-                *m_error = exc.what();
-            }
+        if (!value->IsArray())
+            return false;
+
+        outValue = value.As<v8::Array>();
+        return true;
+    }
+
+    inline bool SignatureArg<Arg::Object>::Bind(v8::Local<v8::Value> value, v8::Local<v8::Object>& outValue)
+    {
+        if (!value->IsObject())
             return false;
+
+        outValue = value.As<v8::Object>();
+        return true;
+    }
+
+    inline bool ArgTypeAccepts(ArgType expected, ArgType actual)
+    {
+        switch (expected)
+        {
+        case ArgType::Unknown:
+            return true;
+
+        case ArgType::Buffer:
+        case ArgType::TypedArray:
+            return actual == ArgType::Buffer || actual == ArgType::TypedArray;
+
+        case ArgType::Object:
+            return actual == ArgType::Object || actual == ArgType::Array || actual == ArgType::Function ||
+                   actual == ArgType::Buffer || actual == ArgType::TypedArray;
+
+        default:
+            return expected == actual;
         }
-        catch (...)
+    }
+
+    inline bool ArgTypeMatches(ArgType expected, v8::Local<v8::Value> value)
+    {
+        return expected == ArgType::Unknown || ArgTypeMatches(expected, ClassifyTraits(value));
+    }
+
+    inline bool ArgTypeMatches(ArgType expected, uint16_t traits)
+    {
+        switch (expected)
         {
-            if (m_error)
-            {
-                *m_error = "Unknown error";
-            }
-            return false;
+        case ArgType::Unknown:
+            return true;
+
+        case ArgType::Boolean:
+            return (traits & ArgTrait::Boolean) != 0;
+
+        case ArgType::Number:
+            return (traits & ArgTrait::Number) != 0;
+
+        case ArgType::String:
+            return (traits & (ArgTrait::String | ArgTrait::StringObject)) != 0;
+
+        case ArgType::Array:
+            return (traits & (ArgTrait::Array | ArgTrait::Buffer | ArgTrait::TypedArray)) != 0;
+
+        case ArgType::Object:
+            return (traits & ArgTrait::Object) != 0;
+
+        default:
+            return ArgTypeAccepts(expected, ArgTypeOf(traits));
         }
     }
 
-    inline CheckArguments& CheckArguments::AddAndClause(InitFunction rightCondition)
+    inline void PayloadArg<Arg::Buffer>::Capture(const v8::Local<v8::Object>& bound, size_t size, char *& storage, Type& outValue)
     {
-        InitFunction prevInit = m_init;
-        InitFunction newInit = [prevInit, rightCondition](Nan::NAN_METHOD_ARGS_TYPE args) {
-            return prevInit(args) && rightCondition(args);
-        };
-        m_init = newInit;
-        return *this;
+        outValue = Span<char>(node::Buffer::Data(bound), node::Buffer::Length(bound));
     }
 
-    inline CheckArguments Check(Nan::NAN_METHOD_ARGS_TYPE args)
+    inline size_t PayloadArg<Arg::String>::StorageSize(const v8::Local<v8::String>& bound)
     {
-        return std::move(CheckArguments(args));
+        return static_cast<size_t>(Nan::DecodeBytes(bound, Nan::UTF8)) + 1;
+    }
+
+    inline void PayloadArg<Arg::String>::Capture(const v8::Local<v8::String>& bound, size_t size, char *& storage, Type& outValue)
+    {
+        size_t length = size - 1;
+        Nan::DecodeWrite(storage, length, bound, Nan::UTF8);
+        storage[length] = 0;
+
+        outValue = Span<const char>(storage, length);
+        storage += length + 1;
     }
 }
\ No newline at end of file
@@ -7,13 +7,8 @@
         "<!(node -e \"require('..')\")", 
         "<!(node -e \"require('nan')\")",
         "<!(node -e \"require('nan-marshal')\")",
-      ]
-  },
-  "targets": [
-  {
-      "target_name" : "asyncprogressworker",
-      "sources"     : [ "cpp/asyncprogressworker.cpp" ],
-      'target_conditions': [              
+      ],
+      'target_conditions': [
         ['OS=="mac"', {
             'xcode_settings': {
                 'GCC_ENABLE_CPP_EXCEPTIONS': 'YES',
@@ -23,10 +18,99 @@
             }
         }],
         ['OS=="linux" or OS=="freebsd" or OS=="openbsd" or OS=="solaris"', {
-        
+
             'libraries!': [ '-undefined dynamic_lookup' ],
             'cflags_cc!': [ '-fno-exceptions', '-fno-rtti' ],
-            "cflags": [ '-std=c++11', '-fexceptions', '-frtti' ],                    
+            "cflags": [ '-std=c++11', '-fexceptions', '-frtti' ],
+        }]
+      ]
+  },
+  "targets": [
+  {
+      "target_name" : "asyncprogressworker",
+      "sources"     : [ "cpp/asyncprogressworker.cpp" ]
+  },
+  {
+      "target_name" : "schema",
+      "sources"     : [ "cpp/schema.cpp" ]
+  },
+  {
+      "target_name" : "signature",
+      "sources"     : [ "cpp/signature.cpp" ]
+  },
+  {
+      "target_name" : "failure",
+      "sources"     : [ "cpp/failure.cpp" ]
+  },
+  {
+      "target_name" : "stringenum",
+      "sources"     : [ "cpp/stringenum.cpp" ]
+  },
+  {
+      "target_name" : "span",
+      "sources"     : [ "cpp/span.cpp" ]
+  },
+  {
+      "target_name" : "arrays",
+      "sources"     : [ "cpp/arrays.cpp" ]
+  }
+, {
+      "target_name" : "properties",
+      "sources"     : [ "cpp/properties.cpp" ]
+  }
+, {
+      "target_name" : "metrics",
+      "sources"     : [ "cpp/metrics.cpp" ],
+      "defines"     : [ "NANCHECK_ENABLE_METRICS=1" ]
+  }
+, {
+      "target_name" : "payload",
+      "sources"     : [ "cpp/payload.cpp" ]
+  }
+, {
+      "target_name" : "overloads",
+      "sources"     : [ "cpp/overloads.cpp" ]
+  }
+, {
+      "target_name" : "fingerprint",
+      "sources"     : [ "cpp/fingerprint.cpp" ]
+  }
+, {
+      "target_name" : "numbers",
+      "sources"     : [ "cpp/numbers.cpp" ]
+  }
+, {
+      "target_name" : "records",
+      "sources"     : [ "cpp/records.cpp" ]
+  }
+, {
+      "target_name" : "sampling",
+      "sources"     : [ "cpp/sampling.cpp" ],
+      "defines"     : [ "NANCHECK_ALWAYS_VALIDATE=0" ]
+  }
+, {
+      "target_name" : "strings",
+      "sources"     : [ "cpp/strings.cpp" ]
+  }
+, {
+      "target_name" : "lazy",
+      "sources"     : [ "cpp/lazy.cpp" ]
+  }
+, {
+      "target_name" : "isolates",
+      "sources"     : [ "cpp/isolates.cpp" ]
+  }
+, {
+      "target_name" : "fastcall",
+      "sources"     : [ "cpp/fastcall.cpp" ]
+  }
+, {
+      "target_name" : "benchmark",
+      "sources"     : [ "cpp/benchmark.cpp" ],
+      'conditions': [
+        ['OS=="linux"', {
+            # Resolve the addon's own operator new so that allocations can be counted
+            'ldflags': [ '-Wl,-Bsymbolic' ]
         }]
       ]
   }
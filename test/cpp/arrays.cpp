@@ -0,0 +1,89 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+static std::vector<double> points;
+
+NAN_METHOD(Sum) {
+
+    const double * data = points.data();
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Elements<double>().Bind(points))
+    {
+        double sum = 0;
+        for (double point : points)
+            sum += point;
+
+        v8::Local<v8::Object> result = New<v8::Object>();
+        Set(result, New<v8::String>("sum").ToLocalChecked(), New<v8::Number>(sum));
+        Set(result, New<v8::String>("reused").ToLocalChecked(), New<v8::Boolean>(data == points.data()));
+        info.GetReturnValue().Set(result);
+    }
+    else
+    {
+        info.GetReturnValue().Set(Null());
+    }
+}
+
+NAN_METHOD(Fill) {
+
+    uint8_t buffer[4];
+    size_t  count = 0;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Elements<uint8_t>().Bind(Span<uint8_t>(buffer, 4), count))
+    {
+        uint32_t packed = 0;
+        for (size_t i = 0; i < count; i++)
+            packed = (packed << 8) | buffer[i];
+
+        info.GetReturnValue().Set(packed);
+    }
+    else
+    {
+        info.GetReturnValue().Set(Null());
+    }
+}
+
+NAN_METHOD(Names) {
+
+    std::vector<std::string> names;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(names))
+    {
+        std::string joined;
+        for (const std::string& name : names)
+            joined += name;
+
+        info.GetReturnValue().Set(New<v8::String>(joined).ToLocalChecked());
+    }
+    else
+    {
+        info.GetReturnValue().Set(Null());
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("sum").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Sum)->GetFunction());
+  Set(target
+    , New<v8::String>("fill").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Fill)->GetFunction());
+  Set(target
+    , New<v8::String>("names").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Names)->GetFunction());
+}
+
+NODE_MODULE(arrays, Init)
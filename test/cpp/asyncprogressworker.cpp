@@ -15,14 +15,14 @@
 
 using namespace Nan;  // NOLINT(build/namespaces)
 
-class ProgressWorker : public AsyncProgressWorker {
+class ProgressWorker : public PooledCallbackWorker<AsyncProgressWorker> {
  public:
   ProgressWorker(
-      Callback *callback
-    , Callback *progress
+      PooledCallback &&callback
+    , PooledCallback &&progress
     , int milliseconds
     , int iters)
-    : AsyncProgressWorker(callback), progress(progress)
+    : PooledCallbackWorker(std::move(callback)), progress(std::move(progress))
     , milliseconds(milliseconds), iters(iters) {}
   ~ProgressWorker() {}
 
@@ -39,19 +39,19 @@ class ProgressWorker : public AsyncProgressWorker {
     v8::Local<v8::Value> argv[] = {
         New<v8::Integer>(*reinterpret_cast<int*>(const_cast<char*>(data)))
     };
-    progress->Call(1, argv);
+    progress.Call(1, argv, async_resource);
   }
 
  private:
-  Callback *progress;
+  PooledCallback progress;
   int milliseconds;
   int iters;
 };
 
 NAN_METHOD(DoProgress) {
 
-    v8::Local<v8::Function> _progress;
-    v8::Local<v8::Function> _callback;
+    PooledCallback progress;
+    PooledCallback callback;
 
     uint32_t i, j;
     std::string error;
@@ -59,12 +59,86 @@ NAN_METHOD(DoProgress) {
     if (Nan::Check(info).ArgumentsCount(4)
         .Argument(0).Bind(i)
         .Argument(1).Bind(j)
-        .Argument(2).IsFunction().Bind(_progress)
-        .Argument(3).IsFunction().Bind(_callback).Error(&error))
+        .Argument(2).IsFunction().Bind(progress)
+        .Argument(3).IsFunction().Bind(callback).Error(&error))
     {
+        AsyncQueueWorker(new ProgressWorker(std::move(callback), std::move(progress), i, j));
+    }
+    else
+    {
+        ThrowSyntaxError(error.c_str());
+    }
+}
+
+class CountingWorker : public AsyncBatchProgressWorker<uint32_t, 256> {
+ public:
+  CountingWorker(
+      Callback *callback
+    , Callback *progress
+    , ProgressPolicy policy
+    , uint32_t iters)
+    : AsyncBatchProgressWorker(callback, policy), progress(progress)
+    , iters(iters) {}
+  ~CountingWorker() { delete progress; }
+
+  void Execute (const ExecutionProgress& progress) {
+    for (uint32_t i = 0; i < iters; ++i) {
+      progress.Send(i);
+      if (i % 8 == 0)
+        Sleep(1);
+    }
+  }
+
+  void HandleProgressCallback(const uint32_t *values, size_t count) {
+    v8::Local<v8::Array> batch = New<v8::Array>(static_cast<int>(count));
+    for (size_t i = 0; i < count; ++i)
+      Set(batch, static_cast<uint32_t>(i), New<v8::Uint32>(values[i]));
+
+    v8::Local<v8::Value> argv[] = { batch };
+    progress->Call(1, argv, async_resource);
+  }
+
+  void HandleOKCallback() {
+    HandleScope scope;
+
+    v8::Local<v8::Value> argv[] = {
+        Null()
+      , New<v8::Number>(static_cast<double>(Dropped()))
+    };
+    callback->Call(2, argv, async_resource);
+  }
+
+ private:
+  Callback *progress;
+  uint32_t iters;
+};
+
+static const StringEnumTable<ProgressCoalescing> policies({
+    { "latest",     ProgressCoalescing::Latest },
+    { "batch",      ProgressCoalescing::Batch },
+    { "throttle",   ProgressCoalescing::Throttle } });
+
+NAN_METHOD(DoBatchProgress) {
+
+    v8::Local<v8::Function> _progress;
+    v8::Local<v8::Function> _callback;
+
+    uint32_t iters, interval;
+    ProgressPolicy policy;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(5)
+        .Argument(0).Bind(iters)
+        .Argument(1).StringEnum(policies).Bind(policy.mMode)
+        .Argument(2).Bind(interval)
+        .Argument(3).IsFunction().Bind(_progress)
+        .Argument(4).IsFunction().Bind(_callback).Error(&error))
+    {
+        policy.mIntervalMs = interval;
+
         Callback *progress = new Callback(_progress);
         Callback *callback = new Callback(_callback);
-        AsyncQueueWorker(new ProgressWorker(callback, progress, i, j));
+        AsyncQueueWorker(new CountingWorker(callback, progress, policy, iters));
     }
     else
     {
@@ -76,6 +150,12 @@ NAN_MODULE_INIT(Init) {
   Set(target
     , New<v8::String>("a").ToLocalChecked()
     , New<v8::FunctionTemplate>(DoProgress)->GetFunction());
+  Set(target
+    , New<v8::String>("b").ToLocalChecked()
+    , New<v8::FunctionTemplate>(DoBatchProgress)->GetFunction());
+  Set(target
+    , New<v8::String>("callbackPoolStats").ToLocalChecked()
+    , New<v8::FunctionTemplate>(GetCallbackPoolStats)->GetFunction());
 }
 
 NODE_MODULE(asyncprogressworker, Init)
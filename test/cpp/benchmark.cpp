@@ -0,0 +1,319 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+// Counts heap allocations made by this addon (including the ones inlined from nan-check.h).
+// On Linux the addon is linked with -Bsymbolic so that its own calls resolve to these operators.
+static std::atomic<size_t> allocations(0);
+
+void * operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    void * ptr = std::malloc(size ? size : 1);
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void * operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void * ptr) NANCHECK_NOTHROW
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr) NANCHECK_NOTHROW
+{
+    std::free(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void * ptr, std::size_t) NANCHECK_NOTHROW
+{
+    std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) NANCHECK_NOTHROW
+{
+    std::free(ptr);
+}
+#endif
+
+enum class PatternType
+{
+    CHESSBOARD,
+    CIRCLES_GRID,
+    ACIRCLES_GRID
+};
+
+static const StringEnumTable<PatternType> patterns({
+    { "CHESSBOARD",     PatternType::CHESSBOARD },
+    { "CIRCLES_GRID",   PatternType::CIRCLES_GRID },
+    { "ACIRCLES_GRID",  PatternType::ACIRCLES_GRID } });
+
+// Every method returns its result on success and `false` on failure rather than throwing,
+// so that the fail path measures validation and not exception propagation.
+
+//////////////////////////////////////////////////////////////////////////
+// (a) Nan::Check fluent chain
+
+NAN_METHOD(CheckNumbers) {
+    double a, b, c;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(3)
+        .Argument(0).Bind(a)
+        .Argument(1).Bind(b)
+        .Argument(2).Bind(c)
+        .Failure(&failure))
+        info.GetReturnValue().Set(a + b + c);
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_METHOD(CheckString) {
+    std::string value;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).IsString().Bind(value)
+        .Failure(&failure))
+        info.GetReturnValue().Set(static_cast<uint32_t>(value.size()));
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_METHOD(CheckBuffer) {
+    Span<const uint8_t> bytes;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(bytes)
+        .Failure(&failure))
+        info.GetReturnValue().Set(static_cast<uint32_t>(bytes.Length()));
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_METHOD(CheckEnum) {
+    PatternType pattern;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).StringEnum(patterns).Bind(pattern)
+        .Failure(&failure))
+        info.GetReturnValue().Set(static_cast<int>(pattern));
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_METHOD(CheckCallback) {
+    v8::Local<v8::Function> callback;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).IsFunction().Bind(callback)
+        .Failure(&failure))
+        info.GetReturnValue().Set(true);
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_METHOD(CheckTen) {
+    double v[10];
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(10)
+        .Argument(0).Bind(v[0])
+        .Argument(1).Bind(v[1])
+        .Argument(2).Bind(v[2])
+        .Argument(3).Bind(v[3])
+        .Argument(4).Bind(v[4])
+        .Argument(5).Bind(v[5])
+        .Argument(6).Bind(v[6])
+        .Argument(7).Bind(v[7])
+        .Argument(8).Bind(v[8])
+        .Argument(9).Bind(v[9])
+        .Failure(&failure))
+    {
+        double sum = 0;
+        for (int i = 0; i < 10; i++)
+            sum += v[i];
+        info.GetReturnValue().Set(sum);
+    }
+    else
+    {
+        info.GetReturnValue().Set(false);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// (b) Hand-written info[i]->IsX() checks
+
+NAN_METHOD(ManualNumbers) {
+    if (info.Length() != 3 || !info[0]->IsNumber() || !info[1]->IsNumber() || !info[2]->IsNumber())
+        return info.GetReturnValue().Set(false);
+
+    double a = To<double>(info[0]).FromJust();
+    double b = To<double>(info[1]).FromJust();
+    double c = To<double>(info[2]).FromJust();
+    info.GetReturnValue().Set(a + b + c);
+}
+
+NAN_METHOD(ManualString) {
+    if (info.Length() != 1 || !info[0]->IsString())
+        return info.GetReturnValue().Set(false);
+
+    Utf8String value(info[0]);
+    info.GetReturnValue().Set(static_cast<uint32_t>(value.length()));
+}
+
+NAN_METHOD(ManualBuffer) {
+    if (info.Length() != 1 || !node::Buffer::HasInstance(info[0]))
+        return info.GetReturnValue().Set(false);
+
+    info.GetReturnValue().Set(static_cast<uint32_t>(node::Buffer::Length(info[0])));
+}
+
+NAN_METHOD(ManualEnum) {
+    if (info.Length() != 1 || !info[0]->IsString())
+        return info.GetReturnValue().Set(false);
+
+    Utf8String value(info[0]);
+    if (strcmp(*value, "CHESSBOARD") == 0)
+        info.GetReturnValue().Set(static_cast<int>(PatternType::CHESSBOARD));
+    else if (strcmp(*value, "CIRCLES_GRID") == 0)
+        info.GetReturnValue().Set(static_cast<int>(PatternType::CIRCLES_GRID));
+    else if (strcmp(*value, "ACIRCLES_GRID") == 0)
+        info.GetReturnValue().Set(static_cast<int>(PatternType::ACIRCLES_GRID));
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_METHOD(ManualCallback) {
+    if (info.Length() != 1 || !info[0]->IsFunction())
+        return info.GetReturnValue().Set(false);
+
+    v8::Local<v8::Function> callback = info[0].As<v8::Function>();
+    info.GetReturnValue().Set(!callback.IsEmpty());
+}
+
+NAN_METHOD(ManualTen) {
+    if (info.Length() != 10)
+        return info.GetReturnValue().Set(false);
+
+    double sum = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        if (!info[i]->IsNumber())
+            return info.GetReturnValue().Set(false);
+        sum += To<double>(info[i]).FromJust();
+    }
+    info.GetReturnValue().Set(sum);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// (c) No checks at all
+
+NAN_METHOD(NoneNumbers) {
+    double a = To<double>(info[0]).FromJust();
+    double b = To<double>(info[1]).FromJust();
+    double c = To<double>(info[2]).FromJust();
+    info.GetReturnValue().Set(a + b + c);
+}
+
+NAN_METHOD(NoneString) {
+    Utf8String value(info[0]);
+    info.GetReturnValue().Set(static_cast<uint32_t>(value.length()));
+}
+
+NAN_METHOD(NoneBuffer) {
+    TypedArrayContents<uint8_t> bytes(info[0]);
+    info.GetReturnValue().Set(static_cast<uint32_t>(bytes.length()));
+}
+
+NAN_METHOD(NoneEnum) {
+    Utf8String value(info[0]);
+    if (strcmp(*value, "CHESSBOARD") == 0)
+        info.GetReturnValue().Set(static_cast<int>(PatternType::CHESSBOARD));
+    else if (strcmp(*value, "CIRCLES_GRID") == 0)
+        info.GetReturnValue().Set(static_cast<int>(PatternType::CIRCLES_GRID));
+    else
+        info.GetReturnValue().Set(static_cast<int>(PatternType::ACIRCLES_GRID));
+}
+
+NAN_METHOD(NoneCallback) {
+    v8::Local<v8::Function> callback = info[0].As<v8::Function>();
+    info.GetReturnValue().Set(!callback.IsEmpty());
+}
+
+NAN_METHOD(NoneTen) {
+    double sum = 0;
+    for (int i = 0; i < 10; i++)
+        sum += To<double>(info[i]).FromJust();
+    info.GetReturnValue().Set(sum);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+NAN_METHOD(Allocations) {
+    info.GetReturnValue().Set(static_cast<double>(allocations.load(std::memory_order_relaxed)));
+}
+
+static void Export(v8::Local<v8::Object> target, const char * name, FunctionCallback method)
+{
+    Set(target
+      , New<v8::String>(name).ToLocalChecked()
+      , New<v8::FunctionTemplate>(method)->GetFunction());
+}
+
+NAN_MODULE_INIT(Init) {
+    v8::Local<v8::Object> check  = New<v8::Object>();
+    v8::Local<v8::Object> manual = New<v8::Object>();
+    v8::Local<v8::Object> none   = New<v8::Object>();
+
+    Export(check, "numbers",  CheckNumbers);
+    Export(check, "string",   CheckString);
+    Export(check, "buffer",   CheckBuffer);
+    Export(check, "enum",     CheckEnum);
+    Export(check, "callback", CheckCallback);
+    Export(check, "ten",      CheckTen);
+
+    Export(manual, "numbers",  ManualNumbers);
+    Export(manual, "string",   ManualString);
+    Export(manual, "buffer",   ManualBuffer);
+    Export(manual, "enum",     ManualEnum);
+    Export(manual, "callback", ManualCallback);
+    Export(manual, "ten",      ManualTen);
+
+    Export(none, "numbers",  NoneNumbers);
+    Export(none, "string",   NoneString);
+    Export(none, "buffer",   NoneBuffer);
+    Export(none, "enum",     NoneEnum);
+    Export(none, "callback", NoneCallback);
+    Export(none, "ten",      NoneTen);
+
+    Set(target, New<v8::String>("check").ToLocalChecked(), check);
+    Set(target, New<v8::String>("manual").ToLocalChecked(), manual);
+    Set(target, New<v8::String>("none").ToLocalChecked(), none);
+    Export(target, "allocations", Allocations);
+}
+
+NODE_MODULE(benchmark, Init)
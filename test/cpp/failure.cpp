@@ -0,0 +1,63 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+static v8::Local<v8::Object> FailureToObject(const CheckFailure& failure) {
+  v8::Local<v8::Object> result = New<v8::Object>();
+  Set(result, New<v8::String>("code").ToLocalChecked(), New<v8::Integer>(static_cast<int>(failure.mCode)));
+  Set(result, New<v8::String>("index").ToLocalChecked(), New<v8::Integer>(failure.mArgIndex));
+  Set(result, New<v8::String>("expected").ToLocalChecked(), New<v8::String>(ArgTypeName(failure.mExpected)).ToLocalChecked());
+  Set(result, New<v8::String>("actual").ToLocalChecked(), New<v8::String>(ArgTypeName(failure.mActual)).ToLocalChecked());
+  Set(result, New<v8::String>("actualCount").ToLocalChecked(), New<v8::Integer>(failure.mActualCount));
+  Set(result, New<v8::String>("message").ToLocalChecked(), New<v8::String>(failure.Message()).ToLocalChecked());
+  return result;
+}
+
+NAN_METHOD(Fluent) {
+
+    uint32_t                width;
+    v8::Local<v8::Function> callback;
+    CheckFailure            failure;
+
+    if (Nan::Check(info).ArgumentsCount(2, 3)
+        .Argument(0).Bind(width)
+        .Argument(1).IsFunction().Bind(callback).Failure(&failure))
+    {
+        info.GetReturnValue().Set(Null());
+    }
+    else
+    {
+        info.GetReturnValue().Set(FailureToObject(failure));
+    }
+}
+
+NAN_METHOD(Compiled) {
+
+    typedef Signature<uint32_t, Arg::Function> CompiledSignature;
+
+    CompiledSignature::Values values;
+    CheckFailure              failure;
+
+    if (!CompiledSignature::Check(info, &failure, values))
+        return failure.ThrowTypeError();
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("fluent").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Fluent)->GetFunction());
+  Set(target
+    , New<v8::String>("compiled").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Compiled)->GetFunction());
+}
+
+NODE_MODULE(failure, Init)
@@ -0,0 +1,75 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+static double Add(double a, double b) {
+    return a + b;
+}
+
+static uint32_t Select(uint32_t value, bool invert) {
+    return invert ? ~value : value;
+}
+
+static double Sum(Span<const double> values) {
+    double sum = 0;
+    for (double value : values)
+        sum += value;
+    return sum;
+}
+
+static uint32_t Fields(v8::Local<v8::Object> self, uint32_t extra) {
+    return static_cast<uint32_t>(self->InternalFieldCount()) + extra;
+}
+
+static uint32_t touched = 0;
+
+static void Touch(uint32_t value) {
+    touched = value;
+}
+
+NAN_METHOD(Touched) {
+    info.GetReturnValue().Set(touched);
+}
+
+NAN_METHOD(MakeHolder) {
+    v8::Local<v8::ObjectTemplate> tpl = New<v8::ObjectTemplate>();
+    tpl->SetInternalFieldCount(2);
+
+    v8::Local<v8::Object> holder = NewInstance(tpl).ToLocalChecked();
+    Set(holder
+      , New<v8::String>("fields").ToLocalChecked()
+      , GetFunction(NANCHECK_FAST_METHOD(Fields)::Template()).ToLocalChecked());
+    info.GetReturnValue().Set(holder);
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("add").ToLocalChecked()
+    , GetFunction(NANCHECK_FAST_METHOD(Add)::Template()).ToLocalChecked());
+  Set(target
+    , New<v8::String>("select").ToLocalChecked()
+    , GetFunction(NANCHECK_FAST_METHOD(Select)::Template()).ToLocalChecked());
+  Set(target
+    , New<v8::String>("sum").ToLocalChecked()
+    , GetFunction(NANCHECK_FAST_METHOD(Sum)::Template()).ToLocalChecked());
+  Set(target
+    , New<v8::String>("touch").ToLocalChecked()
+    , GetFunction(NANCHECK_FAST_METHOD(Touch)::Template()).ToLocalChecked());
+  Set(target
+    , New<v8::String>("touched").ToLocalChecked()
+    , GetFunction(New<v8::FunctionTemplate>(Touched)).ToLocalChecked());
+  Set(target
+    , New<v8::String>("makeHolder").ToLocalChecked()
+    , GetFunction(New<v8::FunctionTemplate>(MakeHolder)).ToLocalChecked());
+}
+
+NODE_MODULE(fastcall, Init)
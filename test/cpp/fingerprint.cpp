@@ -0,0 +1,55 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+NAN_METHOD(Types) {
+    ArgumentFingerprint fingerprint(info);
+
+    v8::Local<v8::Array> types = New<v8::Array>();
+    for (int i = 0; i < fingerprint.Length(); i++)
+        Set(types, i, New<v8::String>(ArgTypeName(fingerprint.Type(i))).ToLocalChecked());
+
+    info.GetReturnValue().Set(types);
+}
+
+NAN_METHOD(Checked) {
+    std::string             name;
+    v8::Local<v8::Object>   options;
+    v8::Local<v8::Value>    value;
+    CheckFailure            failure;
+    CheckArguments          check = Check(info);
+
+    bool passed = check.ArgumentsCount(3)
+        .Argument(0).IsString().Bind(name)
+        .Argument(1).IsObject().Bind(options)
+        .Argument(2).NotNull().Bind(value)
+        .Failure(&failure);
+
+    // The fingerprint stays available to the caller after evaluation
+    v8::Local<v8::Object> result = New<v8::Object>();
+    Set(result, New<v8::String>("passed").ToLocalChecked(), New<v8::Boolean>(passed));
+    Set(result, New<v8::String>("index").ToLocalChecked(), New<v8::Integer>(failure.mArgIndex));
+    Set(result, New<v8::String>("actual").ToLocalChecked(), New<v8::String>(ArgTypeName(failure.mActual)).ToLocalChecked());
+    Set(result, New<v8::String>("isFunction").ToLocalChecked(), New<v8::Boolean>(check.Fingerprint().Is(1, ArgTrait::Function)));
+    info.GetReturnValue().Set(result);
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("types").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Types)->GetFunction());
+  Set(target
+    , New<v8::String>("checked").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Checked)->GetFunction());
+}
+
+NODE_MODULE(fingerprint, Init)
@@ -0,0 +1,63 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+struct CallCounter
+{
+    CallCounter() : calls(0) {}
+
+    uint32_t calls;
+};
+
+// Reads obj.answer through the cached property key of the current isolate
+NAN_METHOD(Answer) {
+    v8::Local<v8::Object> object;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(object)
+        .Error(&error))
+        info.GetReturnValue().Set(Get(object, PropertyKey("answer").Get()).ToLocalChecked());
+    else
+        ThrowTypeError(error.c_str());
+}
+
+// Counts calls made from the current isolate
+NAN_METHOD(Calls) {
+    Nan::Check(info);
+    info.GetReturnValue().Set(++IsolateContext::Current()->Data<CallCounter>().calls);
+}
+
+NAN_METHOD(Contexts) {
+    info.GetReturnValue().Set(static_cast<uint32_t>(IsolateContext::Count()));
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("answer").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Answer)->GetFunction());
+  Set(target
+    , New<v8::String>("calls").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Calls)->GetFunction());
+  Set(target
+    , New<v8::String>("contexts").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Contexts)->GetFunction());
+}
+
+// Context-aware where available, so that worker threads can load the addon too
+#if defined(NODE_MODULE_INIT)
+NODE_MODULE_INIT() {
+  Init(exports);
+}
+#else
+NODE_MODULE(isolates, Init)
+#endif
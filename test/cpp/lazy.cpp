@@ -0,0 +1,127 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+// Number that counts how many times it has been converted
+struct Counted
+{
+    double value;
+};
+
+static uint32_t conversions = 0;
+
+namespace Nan
+{
+    template <>
+    struct ArgBinder<Counted>
+    {
+        static bool Bind(v8::Local<v8::Value> value, Counted& outValue)
+        {
+            conversions++;
+            return ArgBinder<double>::Bind(value, outValue.value);
+        }
+    };
+
+    template <>
+    struct ExpectedArgType<Counted>
+    {
+        static const ArgType value = ArgType::Number;
+    };
+}
+
+// Returns twice the second or the third argument depending on the first one; the other one is never converted
+NAN_METHOD(Choose) {
+    bool first;
+    Lazy<Counted> a, b;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(3)
+        .Argument(0).Bind(first)
+        .Argument(1).Bind(a)
+        .Argument(2).Bind(b)
+        .Error(&error))
+    {
+        Lazy<Counted>& chosen = first ? a : b;
+        double value = chosen.Get().value;
+        // Repeated access is served from the cache
+        info.GetReturnValue().Set(value + chosen.Get().value);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+// Sums the array only when asked to; element types are checked on access
+NAN_METHOD(Sum) {
+    bool enabled;
+    Lazy< std::vector<int32_t> > values;
+    std::string error;
+
+    if (!Nan::Check(info).ArgumentsCount(2)
+        .Argument(0).Bind(enabled)
+        .Argument(1).Bind(values)
+        .Error(&error))
+        return ThrowTypeError(error.c_str());
+
+    if (!enabled)
+        return info.GetReturnValue().Set(values.IsResolved());
+
+    if (!values.Resolve(&error))
+        return ThrowTypeError(error.c_str());
+
+    int32_t sum = 0;
+    for (int32_t v : values.Get())
+        sum += v;
+    info.GetReturnValue().Set(sum);
+}
+
+// Conversion errors surface as CheckException from Get()
+NAN_METHOD(Length) {
+    Lazy< StringBuffer<4> > value;
+    std::string error;
+
+    if (!Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(value)
+        .Error(&error))
+        return ThrowTypeError(error.c_str());
+
+    try
+    {
+        info.GetReturnValue().Set(static_cast<uint32_t>(value.Get().Length()));
+    }
+    catch (const CheckException& e)
+    {
+        ThrowTypeError(e.what());
+    }
+}
+
+NAN_METHOD(Conversions) {
+    info.GetReturnValue().Set(conversions);
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("choose").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Choose)->GetFunction());
+  Set(target
+    , New<v8::String>("sum").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Sum)->GetFunction());
+  Set(target
+    , New<v8::String>("length").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Length)->GetFunction());
+  Set(target
+    , New<v8::String>("conversions").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Conversions)->GetFunction());
+}
+
+NODE_MODULE(lazy, Init)
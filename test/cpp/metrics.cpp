@@ -0,0 +1,61 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+NAN_METHOD(Resize) {
+    uint32_t    width, height;
+    std::string error;
+
+    if (Check(info, "resize").ArgumentsCount(2)
+        .Argument(0).Bind(width)
+        .Argument(1).Bind(height)
+        .Error(&error))
+    {
+        info.GetReturnValue().Set(width * height);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_METHOD(ResizeCopy) {
+    static const std::string name = std::string("re") + "size";
+    uint32_t width, height;
+
+    info.GetReturnValue().Set(static_cast<bool>(Check(info, name.c_str()).ArgumentsCount(2)
+        .Argument(0).Bind(width)
+        .Argument(1).Bind(height)));
+}
+
+NAN_METHOD(Unnamed) {
+    uint32_t value;
+
+    info.GetReturnValue().Set(static_cast<bool>(Check(info).ArgumentsCount(1).Argument(0).Bind(value)));
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("resize").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Resize)->GetFunction());
+  Set(target
+    , New<v8::String>("resizeCopy").ToLocalChecked()
+    , New<v8::FunctionTemplate>(ResizeCopy)->GetFunction());
+  Set(target
+    , New<v8::String>("unnamed").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Unnamed)->GetFunction());
+  Set(target
+    , New<v8::String>("metrics").ToLocalChecked()
+    , New<v8::FunctionTemplate>(GetCheckMetrics)->GetFunction());
+}
+
+NODE_MODULE(metrics, Init)
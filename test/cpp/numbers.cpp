@@ -0,0 +1,51 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+// Each method binds its single argument and returns it as R, or throws the check error
+template <typename T, typename R = T>
+static void BindOne(Nan::NAN_METHOD_ARGS_TYPE info) {
+    T value;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(value).Error(&error))
+        info.GetReturnValue().Set(static_cast<R>(value));
+    else
+        ThrowTypeError(error.c_str());
+}
+
+NAN_METHOD(Int32)  { BindOne<int32_t>(info); }
+NAN_METHOD(Uint32) { BindOne<uint32_t>(info); }
+NAN_METHOD(Double) { BindOne<double>(info); }
+NAN_METHOD(Bool)   { BindOne<bool>(info); }
+NAN_METHOD(Uint8)  { BindOne<uint8_t, uint32_t>(info); }
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("int32").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Int32)->GetFunction());
+  Set(target
+    , New<v8::String>("uint32").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Uint32)->GetFunction());
+  Set(target
+    , New<v8::String>("double").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Double)->GetFunction());
+  Set(target
+    , New<v8::String>("bool").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Bool)->GetFunction());
+  Set(target
+    , New<v8::String>("uint8").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Uint8)->GetFunction());
+}
+
+NODE_MODULE(numbers, Init)
@@ -0,0 +1,105 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+enum class Interpolation
+{
+    NEAREST,
+    LINEAR
+};
+
+namespace Nan {
+    template <>
+    const StringEnumTable<Interpolation>& StringEnumValues<Interpolation>()
+    {
+        static const StringEnumTable<Interpolation> table({
+            { "NEAREST",    Interpolation::NEAREST },
+            { "LINEAR",     Interpolation::LINEAR } });
+        return table;
+    }
+}
+
+typedef Overloads<
+    Signature<Arg::Buffer, uint32_t, uint32_t, Arg::Function>,
+    Signature<Arg::Object, Arg::Function>,
+    Signature< Arg::Enum<Interpolation> > > ResizeOverloads;
+
+NAN_METHOD(Resize) {
+    std::string error;
+
+    bool dispatched = ResizeOverloads::Dispatch(info, &error,
+        [&](v8::Local<v8::Object> buffer, uint32_t width, uint32_t height, v8::Local<v8::Function> callback) {
+            v8::Local<v8::Value> argv[] = { New<v8::String>("buffer").ToLocalChecked(), New<v8::Number>(width * height) };
+            Callback(callback).Call(2, argv);
+        },
+        [&](v8::Local<v8::Object> options, v8::Local<v8::Function> callback) {
+            v8::Local<v8::Value> argv[] = { New<v8::String>("options").ToLocalChecked(), options };
+            Callback(callback).Call(2, argv);
+        },
+        [&](Interpolation interpolation) {
+            info.GetReturnValue().Set(static_cast<int>(interpolation));
+        });
+
+    if (!dispatched)
+        ThrowTypeError(error.c_str());
+}
+
+NAN_METHOD(Select) {
+    info.GetReturnValue().Set(ResizeOverloads::Select(info));
+}
+
+typedef Overloads<
+    Signature<double>,
+    Signature< std::vector<double> >,
+    Signature<Arg::Object> > ScaleOverloads;
+
+NAN_METHOD(Scale) {
+    std::string error;
+
+    bool dispatched = ScaleOverloads::Dispatch(info, &error,
+        [&](double factor) {
+            info.GetReturnValue().Set(factor);
+        },
+        [&](const std::vector<double>& factors) {
+            double product = 1;
+            for (double factor : factors)
+                product *= factor;
+            info.GetReturnValue().Set(product);
+        },
+        [&](v8::Local<v8::Object> options) {
+            info.GetReturnValue().Set(New<v8::String>("options").ToLocalChecked());
+        });
+
+    if (!dispatched)
+        ThrowTypeError(error.c_str());
+}
+
+NAN_METHOD(SelectScale) {
+    info.GetReturnValue().Set(ScaleOverloads::Select(info));
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("resize").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Resize)->GetFunction());
+  Set(target
+    , New<v8::String>("select").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Select)->GetFunction());
+  Set(target
+    , New<v8::String>("scale").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Scale)->GetFunction());
+  Set(target
+    , New<v8::String>("selectScale").ToLocalChecked()
+    , New<v8::FunctionTemplate>(SelectScale)->GetFunction());
+}
+
+NODE_MODULE(overloads, Init)
@@ -0,0 +1,98 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#ifndef _WIN32
+#include <unistd.h>
+#define Sleep(x) usleep((x)*1000)
+#endif
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+typedef Signature<Arg::Buffer, Arg::String, uint32_t, Arg::Function> FillSignature;
+
+// Repeats a pattern into a buffer on the thread pool
+class FillWorker : public PayloadWorker<FillSignature> {
+ public:
+  explicit FillWorker(Payload&& payload)
+    : PayloadWorker(std::move(payload)), written(0) {}
+
+  void Execute() {
+    Span<char>       target  = mPayload.Get<0>();
+    Span<const char> pattern = mPayload.Get<1>();
+    uint32_t         times   = mPayload.Get<2>();
+
+    for (uint32_t i = 0; i < times && written + pattern.Length() <= target.Length(); ++i) {
+      memcpy(target.Data() + written, pattern.Data(), pattern.Length());
+      written += pattern.Length();
+    }
+  }
+
+  void HandleOKCallback() {
+    HandleScope scope;
+
+    v8::Local<v8::Value> argv[] = {
+        Null()
+      , New<v8::Number>(static_cast<double>(written))
+    };
+    callback->Call(2, argv, async_resource);
+  }
+
+ private:
+  size_t written;
+};
+
+typedef Signature<uint32_t, Arg::Function, Arg::Function> CountSignature;
+
+class CountWorker : public PayloadWorker<CountSignature, AsyncProgressWorker> {
+ public:
+  explicit CountWorker(Payload&& payload)
+    : PayloadWorker(std::move(payload)) {}
+
+  void Execute(const AsyncProgressWorker::ExecutionProgress& progress) {
+    for (uint32_t i = 0; i < mPayload.Get<0>(); ++i) {
+      progress.Send(reinterpret_cast<const char*>(&i), sizeof(i));
+      Sleep(10);
+    }
+  }
+
+  void HandleProgressCallback(const char *data, size_t size) {
+    HandleScope scope;
+
+    v8::Local<v8::Value> argv[] = {
+        New<v8::Number>(*reinterpret_cast<const uint32_t*>(data))
+    };
+    mPayload.Get<1>()->Call(1, argv, async_resource);
+  }
+};
+
+NAN_METHOD(Fill) {
+    std::string error;
+
+    if (!FillSignature::QueueAs<FillWorker>(info, &error))
+        ThrowTypeError(error.c_str());
+}
+
+NAN_METHOD(Count) {
+    std::string error;
+
+    if (!CountSignature::QueueAs<CountWorker>(info, &error))
+        ThrowTypeError(error.c_str());
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("fill").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Fill)->GetFunction());
+  Set(target
+    , New<v8::String>("count").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Count)->GetFunction());
+}
+
+NODE_MODULE(payload, Init)
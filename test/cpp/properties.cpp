@@ -0,0 +1,98 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+static const PropertyKey kHeight("height");
+
+NAN_METHOD(Area) {
+    double       width;
+    double       height;
+    CheckFailure failure;
+
+    if (Check(info).ArgumentsCount(1)
+        .Argument(0).Property("width").Bind(width)
+        .Argument(0).Property(kHeight).Bind(height)
+        .Failure(&failure))
+    {
+        info.GetReturnValue().Set(width * height);
+    }
+    else
+    {
+        failure.ThrowTypeError();
+    }
+}
+
+NAN_METHOD(Describe) {
+
+    static const CheckSchema schema = Schema().ArgumentsCount(1)
+        .Argument(0).Property("name").Bind<std::string>()
+        .Argument(0).Property("size").Bind<uint32_t>();
+
+    std::string name;
+    uint32_t    size;
+    std::string error;
+
+    if (schema.Check(info, &error, name, size))
+    {
+        info.GetReturnValue().Set(New<v8::String>(name + ":" + std::to_string(size)).ToLocalChecked());
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_METHOD(Pick) {
+    // Every call reuses the same buffer for a different name
+    static char name[32];
+
+    StringBuffer<sizeof(name) - 1> key;
+    double                         value;
+    std::string                    error;
+
+    if (!Check(info).ArgumentsCount(2).Argument(1).Bind(key).Error(&error))
+        return ThrowTypeError(error.c_str());
+
+    memcpy(name, key.Data(), key.Length() + 1);
+
+    if (Check(info).ArgumentsCount(2)
+        .Argument(0).Property(name).Bind(value)
+        .Error(&error))
+    {
+        info.GetReturnValue().Set(value);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_METHOD(SameKey) {
+    info.GetReturnValue().Set(kHeight.Get()->StrictEquals(PropertyKeyCache::Get(kHeight.Name())));
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("area").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Area)->GetFunction());
+  Set(target
+    , New<v8::String>("describe").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Describe)->GetFunction());
+  Set(target
+    , New<v8::String>("pick").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Pick)->GetFunction());
+  Set(target
+    , New<v8::String>("sameKey").ToLocalChecked()
+    , New<v8::FunctionTemplate>(SameKey)->GetFunction());
+}
+
+NODE_MODULE(properties, Init)
@@ -0,0 +1,113 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+struct Rect
+{
+    float x, y, w, h;
+};
+
+struct RectColumns
+{
+    std::vector<float>  x, y;
+    std::vector<bool>   visible;
+};
+
+static const RecordSchema<Rect> rectSchema = RecordSchema<Rect>()
+    .Field("x", &Rect::x)
+    .Field("y", &Rect::y)
+    .Field("w", &Rect::w)
+    .Field("h", &Rect::h);
+
+static const RecordSchema<RectColumns> columnsSchema = RecordSchema<RectColumns>()
+    .Column("x", &RectColumns::x)
+    .Column("y", &RectColumns::y)
+    .Column("visible", &RectColumns::visible);
+
+// Returns the total area of all rects
+NAN_METHOD(Area) {
+    std::vector<Rect> rects;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Records(rectSchema).Bind(rects).Failure(&failure))
+    {
+        double area = 0;
+        for (size_t i = 0; i < rects.size(); i++)
+            area += rects[i].w * rects[i].h;
+        info.GetReturnValue().Set(area);
+    }
+    else
+    {
+        failure.ThrowTypeError();
+    }
+}
+
+// Binds into a fixed buffer of four rects and returns how many were bound
+NAN_METHOD(Fixed) {
+    Rect rects[4];
+    size_t count = 0;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Records(rectSchema).Bind(Span<Rect>(rects, 4), count).Error(&error))
+        info.GetReturnValue().Set(static_cast<uint32_t>(count));
+    else
+        ThrowTypeError(error.c_str());
+}
+
+// Returns the sum of x of the visible points and the sum of y of all points
+NAN_METHOD(Columns) {
+    RectColumns columns;
+    size_t count = 0;
+    CheckFailure failure;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Records(columnsSchema).BindColumns(columns, count).Failure(&failure))
+    {
+        double x = 0, y = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (columns.visible[i])
+                x += columns.x[i];
+            y += columns.y[i];
+        }
+
+        v8::Local<v8::Array> result = New<v8::Array>(2);
+        Set(result, 0, New<v8::Number>(x));
+        Set(result, 1, New<v8::Number>(y));
+        info.GetReturnValue().Set(result);
+    }
+    else
+    {
+        v8::Local<v8::Object> result = New<v8::Object>();
+        Set(result, New<v8::String>("element").ToLocalChecked(), New<v8::Number>(static_cast<double>(failure.mElementIndex)));
+        Set(result, New<v8::String>("property").ToLocalChecked(),
+            New<v8::String>(failure.mProperty ? failure.mProperty : "").ToLocalChecked());
+        Set(result, New<v8::String>("message").ToLocalChecked(), New<v8::String>(failure.Message()).ToLocalChecked());
+        info.GetReturnValue().Set(result);
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("area").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Area)->GetFunction());
+  Set(target
+    , New<v8::String>("fixed").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Fixed)->GetFunction());
+  Set(target
+    , New<v8::String>("columns").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Columns)->GetFunction());
+}
+
+NODE_MODULE(records, Init)
@@ -0,0 +1,64 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+// Built with NDEBUG (see binding.gyp), since other builds always check
+
+NAN_METHOD(SetRate) {
+    uint32_t rate;
+    if (Nan::Check(info).ArgumentsCount(1).Argument(0).Bind(rate))
+        CheckSampling::SetRate(rate);
+}
+
+// Returns whether an object argument was accepted at the global rate
+NAN_METHOD(Object) {
+    v8::Local<v8::Value> value;
+    info.GetReturnValue().Set(static_cast<bool>(
+        Nan::Check(info).ArgumentsCount(1)
+            .Argument(0).IsObject().Bind(value)));
+}
+
+// Returns whether an object argument was accepted at the rate passed as the second argument
+NAN_METHOD(ObjectSampled) {
+    uint32_t rate = To<uint32_t>(info[1]).FromJust();
+    v8::Local<v8::Value> value;
+    info.GetReturnValue().Set(static_cast<bool>(
+        Nan::Check(info).ArgumentsCount(2).Sampled(rate)
+            .Argument(0).IsObject().Bind(value)));
+}
+
+// Returns the bound number, or false; binding still fails on non-numbers when trusted
+NAN_METHOD(NumberTrusted) {
+    double value;
+    if (Nan::Check(info).ArgumentsCount(1).Trusted()
+        .Argument(0).Bind(value))
+        info.GetReturnValue().Set(value);
+    else
+        info.GetReturnValue().Set(false);
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("setRate").ToLocalChecked()
+    , New<v8::FunctionTemplate>(SetRate)->GetFunction());
+  Set(target
+    , New<v8::String>("object").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Object)->GetFunction());
+  Set(target
+    , New<v8::String>("objectSampled").ToLocalChecked()
+    , New<v8::FunctionTemplate>(ObjectSampled)->GetFunction());
+  Set(target
+    , New<v8::String>("numberTrusted").ToLocalChecked()
+    , New<v8::FunctionTemplate>(NumberTrusted)->GetFunction());
+}
+
+NODE_MODULE(sampling, Init)
@@ -0,0 +1,56 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+enum class PatternType
+{
+    CHESSBOARD,
+    CIRCLES_GRID,
+    ACIRCLES_GRID
+};
+
+NAN_METHOD(Describe) {
+
+    static const CheckSchema schema = Schema().ArgumentsCount(3, 4)
+        .Argument(0).Bind<uint32_t>()
+        .Argument(1).StringEnum<PatternType>({
+            { "CHESSBOARD",     PatternType::CHESSBOARD },
+            { "CIRCLES_GRID",   PatternType::CIRCLES_GRID },
+            { "ACIRCLES_GRID",  PatternType::ACIRCLES_GRID } }).Bind()
+        .Argument(2).IsFunction().Bind< v8::Local<v8::Function> >();
+
+    uint32_t                width;
+    PatternType             pattern;
+    v8::Local<v8::Function> callback;
+    std::string             error;
+
+    if (schema.Check(info, &error, width, pattern, callback))
+    {
+        v8::Local<v8::Value> argv[] = {
+            New<v8::Number>(width)
+          , New<v8::Integer>(static_cast<int>(pattern))
+        };
+        Callback(callback).Call(2, argv);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("describe").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Describe)->GetFunction());
+}
+
+NODE_MODULE(schema, Init)
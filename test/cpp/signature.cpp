@@ -0,0 +1,81 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+enum class PatternType
+{
+    CHESSBOARD,
+    CIRCLES_GRID,
+    ACIRCLES_GRID
+};
+
+namespace Nan {
+  template <>
+  const StringEnumTable<PatternType>& StringEnumValues<PatternType>() {
+    static const StringEnumTable<PatternType> table({
+        { "CHESSBOARD",     PatternType::CHESSBOARD },
+        { "CIRCLES_GRID",   PatternType::CIRCLES_GRID },
+        { "ACIRCLES_GRID",  PatternType::ACIRCLES_GRID } });
+    return table;
+  }
+}
+
+typedef Signature<Arg::Buffer, uint32_t, Arg::Enum<PatternType>, Arg::Function> DetectSignature;
+
+NAN_METHOD(Detect) {
+
+    v8::Local<v8::Object>   buffer;
+    uint32_t                width = 0;
+    PatternType             pattern;
+    v8::Local<v8::Function> callback;
+    std::string             error;
+
+    if (DetectSignature::Check(info, &error, buffer, width, pattern, callback))
+    {
+        v8::Local<v8::Value> argv[] = {
+            New<v8::Number>(static_cast<double>(node::Buffer::Length(buffer)))
+          , New<v8::Number>(width)
+          , New<v8::Integer>(static_cast<int>(pattern))
+        };
+        Callback(callback).Call(3, argv);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_METHOD(DetectTuple) {
+
+    DetectSignature::Values values;
+    std::string error;
+
+    if (DetectSignature::Check(info, &error, values))
+    {
+        info.GetReturnValue().Set(New<v8::Number>(std::get<1>(values)));
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("detect").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Detect)->GetFunction());
+  Set(target
+    , New<v8::String>("detectTuple").ToLocalChecked()
+    , New<v8::FunctionTemplate>(DetectTuple)->GetFunction());
+}
+
+NODE_MODULE(signature, Init)
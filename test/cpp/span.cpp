@@ -0,0 +1,65 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+NAN_METHOD(Scale) {
+
+    Span<float> values;
+    double      factor;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(2)
+        .Argument(0).Bind(values)
+        .Argument(1).Bind(factor).Error(&error))
+    {
+        for (float& value : values)
+            value = static_cast<float>(value * factor);
+
+        info.GetReturnValue().Set(static_cast<uint32_t>(values.Length()));
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_METHOD(Checksum) {
+
+    typedef Signature< Span<const uint8_t> > ChecksumSignature;
+
+    Span<const uint8_t> bytes;
+    std::string         error;
+
+    if (ChecksumSignature::Check(info, &error, bytes))
+    {
+        uint32_t sum = 0;
+        for (uint8_t byte : bytes)
+            sum += byte;
+
+        info.GetReturnValue().Set(sum);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("scale").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Scale)->GetFunction());
+  Set(target
+    , New<v8::String>("checksum").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Checksum)->GetFunction());
+}
+
+NODE_MODULE(span, Init)
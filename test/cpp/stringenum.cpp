@@ -0,0 +1,69 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+enum class PatternType
+{
+    CHESSBOARD,
+    CIRCLES_GRID,
+    ACIRCLES_GRID
+};
+
+static const StringEnumTable<PatternType> patterns({
+    { "CHESSBOARD",     PatternType::CHESSBOARD },
+    { "CIRCLES_GRID",   PatternType::CIRCLES_GRID },
+    { "ACIRCLES_GRID",  PatternType::ACIRCLES_GRID },
+    { "CHESSBOARD",     PatternType::ACIRCLES_GRID } });
+
+NAN_METHOD(MatchList) {
+
+    PatternType pattern;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).StringEnum<PatternType>({
+            { "CHESSBOARD",     PatternType::CHESSBOARD },
+            { "CIRCLES_GRID",   PatternType::CIRCLES_GRID },
+            { "ACIRCLES_GRID",  PatternType::ACIRCLES_GRID } }).Bind(pattern))
+    {
+        info.GetReturnValue().Set(static_cast<int>(pattern));
+    }
+    else
+    {
+        info.GetReturnValue().Set(-1);
+    }
+}
+
+NAN_METHOD(MatchTable) {
+
+    PatternType pattern;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).StringEnum(patterns).Bind(pattern))
+    {
+        info.GetReturnValue().Set(static_cast<int>(pattern));
+    }
+    else
+    {
+        info.GetReturnValue().Set(-1);
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("matchList").ToLocalChecked()
+    , New<v8::FunctionTemplate>(MatchList)->GetFunction());
+  Set(target
+    , New<v8::String>("matchTable").ToLocalChecked()
+    , New<v8::FunctionTemplate>(MatchTable)->GetFunction());
+}
+
+NODE_MODULE(stringenum, Init)
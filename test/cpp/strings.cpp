@@ -0,0 +1,92 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+#include <nan.h>
+#include <nan-check.h>
+
+using namespace Nan;  // NOLINT(build/namespaces)
+
+// Rebinding keeps the capacity of a reused string
+NAN_METHOD(Reused) {
+    static std::string value;
+    const char * data = value.data();
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(value).Error(&error))
+    {
+        v8::Local<v8::Object> result = New<v8::Object>();
+        Set(result, New<v8::String>("value").ToLocalChecked(), New<v8::String>(value).ToLocalChecked());
+        Set(result, New<v8::String>("reused").ToLocalChecked(), New<v8::Boolean>(data == value.data()));
+        info.GetReturnValue().Set(result);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_METHOD(Fixed) {
+    StringBuffer<8> value;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(value).Error(&error))
+        info.GetReturnValue().Set(New<v8::String>(value.c_str()).ToLocalChecked());
+    else
+        ThrowTypeError(error.c_str());
+}
+
+NAN_METHOD(Limited) {
+    std::string value;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).IsString().MaxLength(4).Bind(value).Error(&error))
+        info.GetReturnValue().Set(New<v8::String>(value).ToLocalChecked());
+    else
+        ThrowTypeError(error.c_str());
+}
+
+// Returns [length, isExternal, last character code]
+NAN_METHOD(OneByte) {
+    OneByteString value;
+    std::string error;
+
+    if (Nan::Check(info).ArgumentsCount(1)
+        .Argument(0).Bind(value).Error(&error))
+    {
+        v8::Local<v8::Array> result = New<v8::Array>(2);
+        Set(result, 0, New<v8::Number>(static_cast<double>(value.Length())));
+        Set(result, 1, New<v8::Boolean>(value.IsExternal()));
+        if (value.Length() > 0)
+            Set(result, 2, New<v8::Number>(static_cast<unsigned char>(value.Data()[value.Length() - 1])));
+        info.GetReturnValue().Set(result);
+    }
+    else
+    {
+        ThrowTypeError(error.c_str());
+    }
+}
+
+NAN_MODULE_INIT(Init) {
+  Set(target
+    , New<v8::String>("reused").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Reused)->GetFunction());
+  Set(target
+    , New<v8::String>("fixed").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Fixed)->GetFunction());
+  Set(target
+    , New<v8::String>("limited").ToLocalChecked()
+    , New<v8::FunctionTemplate>(Limited)->GetFunction());
+  Set(target
+    , New<v8::String>("oneByte").ToLocalChecked()
+    , New<v8::FunctionTemplate>(OneByte)->GetFunction());
+}
+
+NODE_MODULE(strings, Init)
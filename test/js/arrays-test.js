@@ -0,0 +1,31 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'arrays' });
+
+test('arrays', function (t) {
+  t.ok(bindings.sum([1, 2, 3, 4]).sum === 10, 'binds packed SMI array')
+  t.ok(bindings.sum([0.5, 1.5, 2]).sum === 4, 'binds packed double array')
+  t.ok(bindings.sum([1, 2, 3]).reused, 'reuses vector capacity')
+  t.ok(bindings.sum([]).sum === 0, 'binds empty array')
+  t.ok(bindings.sum([1, 'two', 3]) === null, 'validates element types')
+  t.ok(bindings.sum(new Float32Array([1, 2, 4])).sum === 7, 'converts typed arrays')
+  t.ok(bindings.sum(new Float64Array([1, 2, 8])).sum === 11, 'copies typed arrays of the same type')
+
+  t.ok(bindings.fill([1, 2, 3]) === 0x010203, 'fills caller buffer')
+  t.ok(bindings.fill(new Uint8Array([4, 5])) === 0x0405, 'fills caller buffer from typed array')
+  t.ok(bindings.fill([1, 2, 3, 4, 5]) === null, 'rejects arrays that do not fit')
+  t.ok(bindings.fill([1, 256]) === null, 'rejects out of range elements')
+  t.ok(bindings.fill([1.5]) === null, 'rejects fractional elements')
+  t.ok(bindings.fill(new Float32Array([1.5])) === null, 'rejects fractional typed array elements')
+
+  t.ok(bindings.names(['a', 'b', 'c']) === 'abc', 'binds non-numeric elements')
+  t.end()
+})
@@ -21,3 +21,101 @@ test('asyncprogressworker', function (t) {
     t.end()
   })
 })
+
+test('asyncprogressworker returns callbacks to the pool', function (t) {
+  var pending = 3
+  for (var i = 0; i < 3; i++) {
+    bindings.a(1, 1, function () {}, function () {
+      if (--pending) return
+      // Workers are destroyed in uv_close callbacks, after the completion callback returns
+      setTimeout(function () {
+        var stats = bindings.callbackPoolStats()
+        t.equal(stats.inUse, 0, 'all callbacks returned')
+        t.ok(stats.highWaterMark >= 6, 'high-water mark counts concurrent workers')
+        t.equal(stats.size, stats.highWaterMark, 'released callbacks are kept for reuse')
+
+        bindings.a(1, 1, function () {}, function () {
+          setTimeout(function () {
+            t.equal(bindings.callbackPoolStats().size, stats.size, 'later calls reuse pooled callbacks')
+            t.end()
+          }, 10)
+        })
+      }, 10)
+    })
+  }
+})
+
+function collect(policy, iters, interval, done) {
+  var batches = []
+    , started = Date.now()
+  bindings.b(iters, policy, interval, function (values) {
+    batches.push(values)
+  }, function (err, dropped) {
+    done(batches, dropped, Date.now() - started)
+  })
+}
+
+function range(n) {
+  var values = []
+  for (var i = 0; i < n; i++) values.push(i)
+  return values
+}
+
+test('asyncprogressworker batch delivers every update in order', function (t) {
+  collect('batch', 200, 0, function (batches, dropped) {
+    t.equal(dropped, 0, 'nothing dropped')
+    t.deepEqual([].concat.apply([], batches), range(200), 'all updates in order')
+    t.ok(batches.length < 200, 'updates were coalesced into ' + batches.length + ' callbacks')
+    t.end()
+  })
+})
+
+test('asyncprogressworker latest delivers increasing values ending with the last one', function (t) {
+  collect('latest', 200, 0, function (batches) {
+    var values = batches.map(function (batch) {
+      t.equal(batch.length, 1, 'one value per callback')
+      return batch[0]
+    })
+    for (var i = 1; i < values.length; i++)
+      t.ok(values[i] > values[i - 1], 'value ' + values[i] + ' follows ' + values[i - 1])
+    t.equal(values[values.length - 1], 199, 'last update delivered')
+    t.end()
+  })
+})
+
+test('asyncprogressworker latest delivers only the newest value after an overflow', function (t) {
+  collect('latest', 2000, 0, function (batches, dropped) {
+    var values = batches.map(function (batch) {
+      t.equal(batch.length, 1, 'one value per callback')
+      return batch[0]
+    })
+    t.ok(dropped > 0, 'the ring overflowed')
+    for (var i = 1; i < values.length; i++)
+      t.ok(values[i] > values[i - 1], 'value ' + values[i] + ' follows ' + values[i - 1])
+    t.equal(values[values.length - 1], 1999, 'last update delivered')
+    t.end()
+  })
+
+  // Keep the loop busy so that the ring fills up before anything is delivered
+  var until = Date.now() + 1000
+  while (Date.now() < until) {}
+})
+
+test('asyncprogressworker throttle bounds the callback rate', function (t) {
+  collect('throttle', 1000, 20, function (batches, dropped, elapsed) {
+    var values = [].concat.apply([], batches)
+      , limit = Math.floor(elapsed / 20) + 2
+    t.ok(batches.length <= limit, batches.length + ' callbacks within ' + limit)
+    t.equal(values.length, 1000 - dropped, 'every kept update delivered')
+    for (var i = 1; i < values.length; i++)
+      if (values[i] <= values[i - 1]) break
+    t.equal(i, values.length, 'updates in order')
+    t.equal(values[values.length - 1], 999, 'last update delivered')
+    t.end()
+  })
+})
+
+test('asyncprogressworker rejects unknown policies', function (t) {
+  t.throws(function () { bindings.b(1, 'sometimes', 0, function () {}, function () {}) })
+  t.end()
+})
@@ -0,0 +1,74 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+// Measures the per-call cost of argument validation.
+// Usage: node test/js/benchmark.js [iterations]
+
+const testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'benchmark' });
+
+var iterations = parseInt(process.argv[2], 10) || 1000000
+  , buffer     = Buffer.alloc ? Buffer.alloc(64) : new Buffer(64)
+  , callback   = function () {}
+  , ten        = [0, 1, 2, 3, 4, 5, 6, 7, 8, 9];
+
+var cases = [
+  { name: 'numbers',  pass: [1, 2, 3],          fail: [1, 'x', 3] },
+  { name: 'string',   pass: ['hello world'],    fail: [42] },
+  { name: 'buffer',   pass: [buffer],           fail: ['buffer'] },
+  { name: 'enum',     pass: ['CIRCLES_GRID'],   fail: ['SQUARES'] },
+  { name: 'callback', pass: [callback],         fail: [null] },
+  { name: 'ten',      pass: ten,                fail: ten.slice(0, 9).concat(['x']) }
+];
+
+var variants = ['check', 'manual', 'none'];
+
+function measure(method, args) {
+  // Warm up so that both V8 and the addon's caches are hot
+  for (var i = 0; i < 10000; i++)
+    method.apply(null, args);
+
+  var allocations = bindings.allocations()
+    , start       = process.hrtime();
+
+  for (var j = 0; j < iterations; j++)
+    method.apply(null, args);
+
+  var elapsed = process.hrtime(start);
+  return {
+    ns:          (elapsed[0] * 1e9 + elapsed[1]) / iterations,
+    allocations: (bindings.allocations() - allocations) / iterations
+  };
+}
+
+function pad(value, width) {
+  value = String(value);
+  while (value.length < width)
+    value = ' ' + value;
+  return value;
+}
+
+console.log(pad('method', 10) + pad('path', 6) + variants.map(function (variant) {
+  return pad(variant + ' ns', 12) + pad('allocs', 8);
+}).join(''));
+
+cases.forEach(function (c) {
+  ['pass', 'fail'].forEach(function (path) {
+    var line = pad(c.name, 10) + pad(path, 6);
+    variants.forEach(function (variant) {
+      // Unchecked methods are not safe to call with bad arguments
+      if (variant === 'none' && path === 'fail') {
+        line += pad('-', 12) + pad('-', 8);
+        return;
+      }
+      var result = measure(bindings[variant][c.name], c[path]);
+      line += pad(result.ns.toFixed(1), 12) + pad(result.allocations.toFixed(2), 8);
+    });
+    console.log(line);
+  });
+});
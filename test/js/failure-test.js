@@ -0,0 +1,30 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'failure' });
+
+test('failure', function (t) {
+  t.ok(bindings.fluent(1, function () {}) === null, 'passes valid arguments')
+
+  var count = bindings.fluent(1)
+  t.ok(count.code === 1, 'reports arguments count failure')
+  t.ok(count.actualCount === 1, 'keeps actual arguments count')
+
+  var check = bindings.fluent(1, 'callback')
+  t.ok(check.code === 2 && check.index === 1, 'reports failed check and argument index')
+  t.ok(check.expected === 'function' && check.actual === 'string', 'reports expected and actual types')
+  t.ok(check.message === 'Argument 1 violates IsFunction check', 'formats message on demand')
+
+  var bind = bindings.fluent('wide', function () {})
+  t.ok(bind.code === 3 && bind.index === 0, 'reports failed binding')
+
+  t.throws(function () { bindings.compiled(1, {}) }, TypeError, 'throws TypeError from failure record')
+  t.end()
+})
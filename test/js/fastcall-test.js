@@ -0,0 +1,46 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'fastcall' });
+
+function message (fn) {
+  try {
+    fn()
+  } catch (e) {
+    return e instanceof TypeError ? e.message : null
+  }
+  return null
+}
+
+test('fastcall', function (t) {
+  t.ok(bindings.add(1, 2) === 3, 'calls the native function')
+  t.ok(bindings.add(0.25, 0.5) === 0.75, 'passes doubles unchanged')
+  t.equal(message(function () { bindings.add(1, 'x') }), 'Argument 1 violates Bind check',
+    'reports mistyped arguments like Signature')
+  t.ok(message(function () { bindings.add(1) }) !== null, 'checks arguments count')
+
+  t.ok(bindings.select(5, false) === 5 && bindings.select(0, true) === 4294967295, 'converts integers and booleans')
+  t.ok(message(function () { bindings.select(1.5, false) }) !== null, 'rejects fractions for integers')
+  t.ok(message(function () { bindings.select(-1, false) }) !== null, 'rejects out of range integers')
+  t.ok(message(function () { bindings.select(1, 1) }) !== null, 'rejects numbers for booleans')
+
+  t.ok(bindings.sum(new Float64Array([1, 2, 3.5])) === 6.5, 'binds typed arrays to spans')
+  t.ok(bindings.sum(new Float64Array(new ArrayBuffer(40), 8, 2)) === 0, 'honours offset views')
+  t.ok(message(function () { bindings.sum([1, 2]) }) !== null, 'rejects plain arrays for spans')
+  t.ok(message(function () { bindings.sum(new Float32Array(2)) }) !== null, 'rejects other element types for spans')
+
+  var holder = bindings.makeHolder()
+  t.ok(holder.fields(1) === 3, 'passes the receiver')
+
+  bindings.touch(7)
+  t.ok(bindings.touched() === 7, 'calls void functions')
+  t.ok(bindings.touch(8) === undefined, 'returns undefined from void functions')
+  t.end()
+})
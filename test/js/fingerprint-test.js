@@ -0,0 +1,34 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'fingerprint' });
+
+test('fingerprint', function (t) {
+  var buffer = Buffer.alloc ? Buffer.alloc(4) : new Buffer(4)
+
+  t.deepEqual(bindings.types(undefined, null, true, 1, 'a', function () {}, buffer, [], {}),
+    ['undefined', 'null', 'boolean', 'number', 'string', 'function', 'buffer', 'array', 'object'],
+    'classifies every argument once')
+  t.deepEqual(bindings.types(new Number(1), new String('a'), new Boolean(false)), ['number', 'string', 'boolean'],
+    'classifies wrapper objects like their primitives')
+
+  var ok = bindings.checked('a', function () {}, 0)
+  t.ok(ok.passed, 'checks read the fingerprint')
+  t.ok(ok.isFunction, 'exposes the fingerprint to the caller')
+
+  t.ok(bindings.checked(new String('a'), {}, 0).passed, 'IsString accepts string objects')
+
+  var notObject = bindings.checked('a', 1, 0)
+  t.ok(!notObject.passed && notObject.index === 1 && notObject.actual === 'number', 'reports the classified type')
+
+  var isNull = bindings.checked('a', {}, null)
+  t.ok(!isNull.passed && isNull.index === 2 && isNull.actual === 'null', 'NotNull rejects null')
+  t.end()
+})
@@ -0,0 +1,44 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'isolates' });
+
+var workers = null
+try {
+  workers = require('worker_threads')
+} catch (e) {
+}
+
+test('isolates', function (t) {
+  t.equal(bindings.answer({ answer: 42 }), 42, 'reads cached property keys')
+  t.equal(bindings.calls(), 1, 'creates per-isolate data on first use')
+  t.equal(bindings.calls(), 2, 'keeps per-isolate data')
+  t.equal(bindings.contexts(), 1, 'creates one context per isolate')
+
+  if (!workers) {
+    t.end()
+    return
+  }
+
+  var script = "const w = require('worker_threads')\n" +
+               "const b = require('bindings')({ module_root: w.workerData.root, bindings: 'isolates' })\n" +
+               "w.parentPort.postMessage([b.answer({ answer: 'worker' }), b.calls(), b.calls(), b.contexts()])\n"
+
+  var worker = new workers.Worker(script, { eval: true, workerData: { root: testRoot } })
+  worker.on('message', function (result) {
+    t.deepEqual(result, ['worker', 1, 2, 2], 'workers get contexts of their own')
+  })
+  worker.on('error', function (e) { t.fail(e.message) })
+  worker.on('exit', function () {
+    t.equal(bindings.contexts(), 1, 'destroys the context of an exited worker')
+    t.equal(bindings.calls(), 3, 'keeps the context of the main isolate')
+    t.end()
+  })
+})
@@ -0,0 +1,31 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'lazy' });
+
+test('lazy', function (t) {
+  var before = bindings.conversions()
+  t.equal(bindings.choose(true, 1, 2), 2, 'converts the chosen argument')
+  t.equal(bindings.choose(false, 1, 2), 4, 'converts the other argument')
+  t.equal(bindings.conversions() - before, 2, 'converts one argument per call, once')
+  t.throws(function () { bindings.choose(true, 1, 'x') }, /Argument 2 violates Bind check/, 'type-checks when binding')
+
+  t.equal(bindings.sum(true, [1, 2, 3]), 6, 'binds arrays')
+  t.equal(bindings.sum(true, new Int32Array([4, 5])), 9, 'binds typed arrays')
+  t.equal(bindings.sum(false, [1, 'x']), false, 'does not convert unused arguments')
+  t.throws(function () { bindings.sum(true, [1, 'x']) }, /Argument 1 violates Lazy check/, 'reports conversion failures on access')
+  t.throws(function () { bindings.sum(true, 1) }, /Argument 1 violates Bind check/, 'rejects non-arrays')
+
+  t.equal(bindings.length('abc'), 3, 'binds strings')
+  t.equal(bindings.length(new String('abcd')), 4, 'binds string objects')
+  t.throws(function () { bindings.length('abcde') }, /Argument 0 violates Lazy check/, 'throws conversion failures from Get()')
+  t.throws(function () { bindings.length(1) }, /Argument 0 violates Bind check/, 'rejects non-strings')
+  t.end()
+})
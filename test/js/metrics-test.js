@@ -0,0 +1,38 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'metrics' });
+
+test('metrics', function (t) {
+  for (var i = 0; i < 5; i++)
+    t.equal(bindings.resize(4, 3), 12, 'binds arguments of call #' + i)
+
+  t.throws(function () { bindings.resize(4) }, TypeError, 'checks arguments count')
+  t.throws(function () { bindings.resize(4, 'x') }, TypeError, 'checks argument type')
+  t.throws(function () { bindings.resize(4, 'y') }, TypeError, 'checks argument type again')
+  t.ok(bindings.unnamed(1), 'unnamed checks still work')
+  t.notOk(bindings.resizeCopy(4, 'z'), 'checks through a copied method name')
+
+  var metrics = bindings.metrics()
+    , resize  = metrics.resize
+  t.deepEqual(Object.keys(metrics), ['resize'], 'records named methods only')
+  t.equal(resize.calls, 9, 'counts calls')
+  t.equal(resize.failures, 4, 'counts failures')
+  t.deepEqual(resize.errors, [
+    { argument: -1, check: 'ArgumentsCount', count: 1 },
+    { argument: 1, check: 'Bind', count: 3 }
+  ], 'merges copied names and breaks failures down by argument and check')
+
+  var latency = 0
+  Object.keys(resize.latency).forEach(function (bound) { latency += resize.latency[bound] })
+  t.equal(latency, 9, 'records latency of every call')
+  t.ok('Infinity' in resize.latency, 'has an unbounded latency bucket')
+  t.end()
+})
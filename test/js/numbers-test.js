@@ -0,0 +1,37 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'numbers' });
+
+test('numbers', function (t) {
+  t.equal(bindings.int32(-5), -5, 'binds int32 from a small integer')
+  t.equal(bindings.int32(2147483647), 2147483647, 'binds the int32 maximum')
+  t.throws(function () { bindings.int32(2147483648) }, 'rejects int32 overflow')
+  t.throws(function () { bindings.int32(1.5) }, 'rejects fractions for int32')
+  t.throws(function () { bindings.int32(NaN) }, 'rejects NaN for int32')
+  t.throws(function () { bindings.int32('1') }, 'rejects numeric strings')
+
+  t.equal(bindings.uint32(4294967295), 4294967295, 'binds the uint32 maximum')
+  t.throws(function () { bindings.uint32(-1) }, 'rejects negative uint32')
+  t.throws(function () { bindings.uint32(4294967296) }, 'rejects uint32 overflow')
+
+  t.equal(bindings.uint8(255), 255, 'binds uint8')
+  t.throws(function () { bindings.uint8(256) }, 'rejects uint8 overflow')
+
+  t.equal(bindings.double(1.5), 1.5, 'binds doubles')
+  t.equal(bindings.double(7), 7, 'binds integral doubles')
+  t.ok(isNaN(bindings.double(NaN)), 'binds NaN to double')
+  t.throws(function () { bindings.double(true) }, 'rejects booleans for double')
+
+  t.equal(bindings.bool(true), true, 'binds true')
+  t.equal(bindings.bool(false), false, 'binds false')
+  t.throws(function () { bindings.bool(1) }, 'rejects numbers for bool')
+  t.end()
+})
@@ -0,0 +1,56 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'overloads' });
+
+test('overloads', function (t) {
+  var buffer = Buffer.alloc ? Buffer.alloc(4) : new Buffer(4)
+    , options = { width: 2 }
+    , cb = function () {}
+
+  t.equal(bindings.select(buffer, 2, 3, cb), 0, 'selects by arity and buffer type')
+  t.equal(bindings.select(options, cb), 1, 'selects by arity and object type')
+  t.equal(bindings.select('LINEAR'), 2, 'selects by string type')
+  t.equal(bindings.select(new String('LINEAR')), 2, 'selects string objects like strings')
+  t.equal(bindings.select(options, options), -1, 'selects nothing for mismatching types')
+  t.equal(bindings.select(), -1, 'selects nothing for mismatching arity')
+
+  bindings.resize(buffer, 2, 3, function (kind, area) {
+    t.equal(kind, 'buffer', 'calls the buffer overload')
+    t.equal(area, 6, 'binds the buffer overload arguments')
+  })
+  bindings.resize(options, function (kind, bound) {
+    t.equal(kind, 'options', 'calls the options overload')
+    t.equal(bound, options, 'binds the options overload arguments')
+  })
+  t.equal(bindings.resize('LINEAR'), 1, 'calls the enum overload')
+  t.equal(bindings.resize(new String('LINEAR')), 1, 'binds string objects to the enum overload')
+
+  t.throws(function () { bindings.resize(1, 2) },
+    /Arguments do not match any overload: expected \(buffer, number, number, function\) or \(object, function\) or \(string\)/,
+    'reports a single error listing all overloads')
+  t.throws(function () { bindings.resize('CUBIC') }, /Argument 0 violates StringEnum check/, 'reports binding failure of the selected overload')
+  t.end()
+})
+
+test('overloads bind what they select', function (t) {
+  t.equal(bindings.selectScale(2), 0, 'selects numbers')
+  t.equal(bindings.selectScale([2, 3]), 1, 'selects arrays')
+  t.equal(bindings.selectScale(new Float64Array([2, 3])), 1, 'selects typed arrays for vectors')
+  t.equal(bindings.selectScale(new Number(2)), 2, 'selects number objects as objects')
+  t.equal(bindings.selectScale(new Boolean(true)), 2, 'selects boolean objects as objects')
+  t.equal(bindings.selectScale(new String('x')), 2, 'selects string objects as objects')
+  t.equal(bindings.selectScale('x'), -1, 'selects nothing for primitive strings')
+
+  t.equal(bindings.scale(2), 2, 'binds numbers')
+  t.equal(bindings.scale(new Float64Array([2, 3])), 6, 'binds typed arrays to vectors')
+  t.equal(bindings.scale(new Number(2)), 'options', 'binds number objects to objects')
+  t.end()
+})
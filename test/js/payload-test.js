@@ -0,0 +1,40 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'payload' });
+
+test('payload', function (t) {
+  t.plan(9)
+
+  var buffer = Buffer.alloc ? Buffer.alloc(8) : new Buffer(8)
+  buffer.fill(0)
+  bindings.fill(buffer, 'ab', 3, function (err, written) {
+    t.equal(err, null, 'completes without error')
+    t.equal(written, 6, 'fills the buffer on the thread pool')
+    t.equal(buffer.toString('ascii', 0, 6), 'ababab', 'writes into the pinned buffer')
+  })
+
+  var boxed = Buffer.alloc ? Buffer.alloc(4) : new Buffer(4)
+  bindings.fill(boxed, new String('xy'), 2, function (err, written) {
+    t.equal(err, null, 'accepts string objects like the fluent checks')
+    t.equal(boxed.toString('ascii', 0, 4), 'xyxy', 'binds the string object value')
+  })
+
+  var progressed = 0
+  bindings.count(3, function (i) {
+    progressed++
+  }, function () {
+    t.ok(progressed > 0, 'reports progress through a payload callback')
+  })
+
+  t.throws(function () { bindings.fill('buffer', 'ab', 3, function () {}) }, TypeError, 'checks arguments before queueing')
+  t.throws(function () { bindings.fill(buffer, 'ab', 3) }, TypeError, 'checks arguments count')
+  t.throws(function () { bindings.count(3, function () {}, 42) }, TypeError, 'checks the completion callback')
+})
@@ -0,0 +1,32 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'properties' });
+
+test('properties', function (t) {
+  t.equal(bindings.area({ width: 3, height: 4 }), 12, 'binds object properties')
+  t.equal(bindings.area({ width: 3, height: 4 }), 12, 'binds with cached keys')
+  t.equal(bindings.area(Object.create({ width: 2, height: 5 })), 10, 'binds inherited properties')
+  t.ok(bindings.sameKey(), 'reuses the internalized key')
+  t.equal(bindings.pick({ a: 1, b: 2 }, 'a'), 1, 'binds a property named by a reused buffer')
+  t.equal(bindings.pick({ a: 1, b: 2 }, 'b'), 2, 'identifies keys by name, not by address')
+
+  t.throws(function () { bindings.area(42) }, /Property 'width' of argument 0 violates Property check/, 'rejects non-object')
+  t.throws(function () { bindings.area({ width: 3 }) }, /Property 'height' of argument 0/, 'rejects missing property')
+  t.throws(function () { bindings.area({ width: 'x', height: 4 }) }, TypeError, 'rejects wrong property type')
+  t.throws(function () { bindings.area({ get width () { throw new Error('no width') }, height: 2 }) },
+    /^Error: no width$/, 'propagates the exception of a throwing getter')
+  t.throws(function () { bindings.area({ width: 2, get height () { throw new RangeError('no height') } }) },
+    RangeError, 'does not throw a TypeError over the getter exception')
+
+  t.equal(bindings.describe({ name: 'board', size: 9 }), 'board:9', 'binds properties through a schema')
+  t.throws(function () { bindings.describe({ name: 'board' }) }, /Property 'size' of argument 0 violates Property check/, 'schema reports the property')
+  t.end()
+})
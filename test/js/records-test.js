@@ -0,0 +1,43 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'records' });
+
+test('records', function (t) {
+  var rects = []
+  for (var i = 0; i < 1000; i++)
+    rects.push({ x: i, y: i, w: 2, h: 3, label: 'rect' })
+
+  t.equal(bindings.area(rects), 6000, 'binds an array of structs')
+  t.equal(bindings.area([]), 0, 'binds an empty array')
+  t.equal(bindings.fixed(rects.slice(0, 3)), 3, 'binds into a fixed buffer')
+  t.throws(function () { bindings.fixed(rects.slice(0, 5)) }, 'rejects arrays that do not fit')
+  t.throws(function () { bindings.area({}) }, /Argument 0 violates Records check/, 'rejects non-arrays')
+
+  rects[700] = { x: 1, y: 2, w: 'wide', h: 3 }
+  t.throws(function () { bindings.area(rects) }, /Property 'w' of element 700 of argument 0 violates Records check/,
+    'stops at the first invalid element')
+  rects[700] = 7
+  t.throws(function () { bindings.area(rects) }, /Element 700 of argument 0 violates Records check/,
+    'rejects elements that are not objects')
+  Object.defineProperty(rects, 700, { get: function () { throw new RangeError('no element') } })
+  t.throws(function () { bindings.area(rects) }, RangeError, 'propagates the exception of an element getter')
+  rects = rects.slice(0, 700)
+  rects.push({ x: 1, y: 2, get w () { throw new RangeError('no width') }, h: 3 })
+  t.throws(function () { bindings.area(rects) }, RangeError, 'propagates the exception of a field getter')
+
+  t.deepEqual(bindings.columns([{ x: 1, y: 2, visible: true }, { x: 10, y: 20, visible: false }]), [1, 22],
+    'binds into a struct of arrays')
+
+  var failure = bindings.columns([{ x: 1, y: 2, visible: true }, { x: 1, y: 2 }])
+  t.equal(failure.element, 1, 'reports the failing element')
+  t.equal(failure.property, 'visible', 'reports the failing property')
+  t.end()
+})
@@ -0,0 +1,41 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'sampling' });
+
+function accepted(call, times) {
+  var count = 0
+  for (var i = 0; i < times; i++)
+    if (call()) count++
+  return count
+}
+
+test('sampling', function (t) {
+  t.ok(bindings.object({}), 'checks every call by default')
+  t.notOk(bindings.object(1), 'rejects invalid arguments by default')
+
+  bindings.setRate(0)
+  t.ok(bindings.object(1), 'skips type checks when trusted')
+  t.ok(bindings.object(1, 2), 'skips the arguments count when trusted')
+
+  bindings.setRate(10)
+  var rejected = 10000 - accepted(function () { return bindings.object(1) }, 10000)
+  t.ok(rejected > 500 && rejected < 1500, 'checks about one call in ten (' + rejected + ' of 10000)')
+
+  bindings.setRate(1)
+  t.notOk(bindings.object(1), 'checks every call again')
+
+  t.equal(accepted(function () { return bindings.objectSampled(1, 0) }, 100), 100, 'per-method rate overrides the global one')
+  t.equal(accepted(function () { return bindings.objectSampled(1, 1) }, 100), 0, 'per-method full checks')
+
+  t.equal(bindings.numberTrusted(1.5), 1.5, 'binds when trusted')
+  t.equal(bindings.numberTrusted('a'), false, 'binding still fails when trusted')
+  t.end()
+})
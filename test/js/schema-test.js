@@ -0,0 +1,28 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'schema' });
+
+test('schema', function (t) {
+  var calls = 0
+  for (var i = 0; i < 3; i++) {
+    bindings.describe(640 + i, 'CIRCLES_GRID', function (width, pattern) {
+      t.ok(width === 640 + calls, 'binds width on call #' + calls)
+      t.ok(pattern === 1, 'binds string enum on call #' + calls)
+      calls++
+    })
+  }
+  t.ok(calls === 3, 'schema is reusable across calls')
+
+  t.throws(function () { bindings.describe(640, 'CIRCLES_GRID') }, TypeError, 'checks arguments count')
+  t.throws(function () { bindings.describe(640, 'SQUARES', function () {}) }, TypeError, 'rejects unknown enum value')
+  t.throws(function () { bindings.describe(640, 'CHESSBOARD', 42) }, TypeError, 'rejects non-function callback')
+  t.end()
+})
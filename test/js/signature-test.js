@@ -0,0 +1,25 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'signature' });
+
+test('signature', function (t) {
+  bindings.detect(new Buffer(16), 640, 'ACIRCLES_GRID', function (length, width, pattern) {
+    t.ok(length === 16, 'binds buffer')
+    t.ok(width === 640, 'binds number')
+    t.ok(pattern === 2, 'binds string enum')
+  })
+  t.ok(bindings.detectTuple(new Buffer(1), 480, 'CHESSBOARD', function () {}) === 480, 'binds into a tuple')
+
+  t.throws(function () { bindings.detect(new Buffer(1), 640, 'CHESSBOARD') }, TypeError, 'checks arguments count')
+  t.throws(function () { bindings.detect('buffer', 640, 'CHESSBOARD', function () {}) }, TypeError, 'rejects non-buffer')
+  t.throws(function () { bindings.detect(new Buffer(1), 640, 'SQUARES', function () {}) }, TypeError, 'rejects unknown enum value')
+  t.end()
+})
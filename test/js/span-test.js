@@ -0,0 +1,29 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'span' });
+
+test('span', function (t) {
+  var values = new Float32Array([1, 2, 3, 4])
+  t.ok(bindings.scale(values, 2) === 4, 'binds typed array length')
+  t.ok(values[0] === 2 && values[3] === 8, 'writes through to the backing store')
+
+  var view = new Float32Array(values.buffer, 4, 2)
+  bindings.scale(view, 10)
+  t.ok(values[0] === 2 && values[1] === 40 && values[2] === 60 && values[3] === 8, 'honours offset views')
+
+  t.throws(function () { bindings.scale(new Float64Array(4), 2) }, TypeError, 'rejects other element types')
+  t.throws(function () { bindings.scale([1, 2], 2) }, TypeError, 'rejects plain arrays')
+
+  t.ok(bindings.checksum(new Buffer([1, 2, 3])) === 6, 'binds buffers to byte spans')
+  t.ok(bindings.checksum(new Uint8Array([4, 5]).subarray(1)) === 5, 'binds Uint8Array views to byte spans')
+  t.throws(function () { bindings.checksum(new Int16Array(2)) }, TypeError, 'rejects wider typed arrays for byte spans')
+  t.end()
+})
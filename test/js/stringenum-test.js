@@ -0,0 +1,28 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'stringenum' });
+
+test('stringenum', function (t) {
+  [bindings.matchList, bindings.matchTable].forEach(function (match) {
+    t.ok(match('CHESSBOARD') === 0, 'matches first key')
+    t.ok(match('CIRCLES_' + 'GRID') === 1, 'matches non-internalized string')
+    t.ok(match('ACIRCLES_GRID') === 2, 'matches last key')
+    t.ok(match(new String('CIRCLES_GRID')) === 1, 'matches string object')
+    t.ok(match('CHESSBOAR') === -1, 'rejects prefix')
+    t.ok(match('CHESSBOARDS') === -1, 'rejects longer string')
+    t.ok(match('CHESSBOARD\0') === -1, 'rejects trailing NUL character')
+    t.ok(match('CHESS\0BOARD') === -1, 'rejects embedded NUL character')
+    t.ok(match(new Array(1000).join('x')) === -1, 'rejects long string')
+    t.ok(match('CHESSBOARDĀ') === -1, 'rejects non-latin1 string')
+    t.ok(match(42) === -1, 'rejects non-string')
+  })
+  t.end()
+})
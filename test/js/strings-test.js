@@ -0,0 +1,38 @@
+/*********************************************************************
+ * NAN - Native Abstractions for Node.js
+ *
+ * Copyright (c) 2015 NAN contributors
+ *
+ * MIT License <https://github.com/nodejs/nan/blob/master/LICENSE.md>
+ ********************************************************************/
+
+const test     = require('tap').test
+    , testRoot = require('path').resolve(__dirname, '..')
+    , bindings = require('bindings')({ module_root: testRoot, bindings: 'strings' });
+
+test('strings', function (t) {
+  t.equal(bindings.reused('a fairly long identifier that is not inlined').value,
+    'a fairly long identifier that is not inlined', 'binds std::string')
+  t.ok(bindings.reused('a shorter identifier').reused, 'reuses the capacity of a bound string')
+  t.equal(bindings.reused(new String('boxed')).value, 'boxed', 'binds string objects')
+  t.equal(bindings.reused('é中').value, 'é中', 'binds UTF-8')
+  t.throws(function () { bindings.reused(1) }, 'rejects non-strings')
+
+  t.equal(bindings.fixed('12345678'), '12345678', 'binds into a fixed buffer')
+  t.throws(function () { bindings.fixed('123456789') }, 'rejects strings longer than the buffer')
+  t.throws(function () { bindings.fixed('1234567é') }, 'measures the buffer in UTF-8 bytes')
+
+  t.equal(bindings.limited('abcd'), 'abcd', 'accepts strings within the limit')
+  t.throws(function () { bindings.limited('abcde') }, /Argument 0 violates MaxLength check/, 'reports length limits')
+  t.throws(function () { bindings.limited('abcé') }, /MaxLength/, 'limits UTF-8 bytes')
+
+  t.deepEqual(bindings.oneByte('café'), [4, false, 0xe9], 'copies short Latin-1 strings')
+  t.deepEqual(bindings.oneByte(new Array(200).join('x')), [199, false, 0x78], 'copies longer Latin-1 strings')
+  t.throws(function () { bindings.oneByte('中') }, 'rejects two-byte strings')
+
+  var big = (Buffer.alloc ? Buffer.alloc(2 * 1024 * 1024, 'z') : new Buffer(2 * 1024 * 1024).fill('z')).toString('latin1')
+  var view = bindings.oneByte(big)
+  t.equal(view[0], big.length, 'views large strings')
+  t.ok(view[1], 'views external strings in place')
+  t.end()
+})